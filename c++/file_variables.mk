@@ -29,6 +29,23 @@ PROBLEM_FILES = $(SRC_DIR)/$(AUX_DIR)/Utilities.cpp \
 				$(SRC_DIR)/$(DIATONY_DIR)/FourVoiceTextureParameters.cpp \
 				$(SRC_DIR)/$(DIATONY_DIR)/SolveDiatony.cpp \
 				$(SRC_DIR)/$(DIATONY_DIR)/FourVoiceTexture.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/SharedCostBound.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/ChainModel.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/ChainSolver.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/ChordVoicingTables.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/VoicingIndexModel.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/ParallelIntervalsPropagator.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/ChordBrancher.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/DiatonySolution.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/RulePosting.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/ConstraintRegistry.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/DiatonySnapshot.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/ParametersValidator.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/BatchSolver.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/DiatonyServer.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/SolutionCache.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/DiatonyCApi.cpp \
+				$(SRC_DIR)/$(DIATONY_DIR)/CancellableStop.cpp \
 
 #MIDI handling files
 MIDI_FILES = $(SRC_DIR)/$(MIDI_DIR)/Options.cpp \
@@ -26,6 +26,14 @@ using namespace smf;
  */
 void writeSolToMIDIFile(int size, const string& fileName, const FourVoiceTexture * sol);
 
+/**
+ * Writes a voicing to a MIDI file
+ * @param size the size of the problem
+ * @param fileName the name of the file, without the extension
+ * @param sol_notes the notes of each voice for each chord [bass0, tenor0, alto0, soprano0, bass1, ...]
+ */
+void writeSolToMIDIFile(int size, const string& fileName, const vector<int>& sol_notes);
+
 /**
  * Writes all the solutions to a MIDI file
  * @param size the size of the problem
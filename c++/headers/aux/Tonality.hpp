@@ -8,24 +8,24 @@
 #include "Utilities.hpp"
 
 /**
- * This class is an abstract class modeling a tonality
+ * This class models a tonality. MajorTonality and MinorTonality build the major and minor tonalities from their tonic.
+ * A tonality is immutable once constructed: all its attributes are computed by the constructors and stored in flat
+ * arrays, and all its methods are const, so a tonality can be read by many solver threads at once. The tonalities
+ * returned by get_tonality are shared by the whole process (flyweights), so they are const and must not be deleted.
  * @todo develop this comment section once the class is finished
  */
-class Tonality { // abstract class
+class Tonality {
 protected:
     string name;                            // name of the tonality
     int tonic;                              // tonic of the tonality
     int mode;                               // mode of the tonality
-    vector<int> scale;                      // scale of the tonality
+    int scale[N_SCALE_NOTES];               // scale of the tonality
 
-    map<int, int> chord_qualities;          // map of [degree, chord_quality] for each degree of the scale (0 to 6) (set by child classes)
-    map<int, int> degrees_notes;            // notes corresponding to the degrees of the scale on which the chords are based
+    int chord_qualities[N_DEGREES];         // default chord quality of each degree (set by child classes)
+    int degrees_notes[N_DEGREES];           // notes corresponding to the degrees of the scale on which the chords are based
 
-    map<int, IntSet> scale_degrees;         // map of [degree, all_notes] for each degree of the scale (0 to 6). May contain multiple notes per degree depending on the mode
-    set<int> tonal_notes;                   // notes that don't change in major or minor mode (1,4,5 degrees)
-    set<int> modal_notes;                   // notes that change in major or minor mode (3,6,7 degrees)
-
-    map<int, IntSet> scale_degrees_chords;  // map of [degree, chord] for each degree of the scale (0 to 6) (set by child classes)
+    int tonal_notes;                        // mask of the notes that don't change in major or minor mode (1,4,5 degrees)
+    int modal_notes;                        // mask of the notes that change in major or minor mode (3,6,7 degrees)
 
 public:
     /**
@@ -33,94 +33,85 @@ public:
      * Creates a tonality object based on the tonality (tonic, mode and scale)
      * @param t the tonic of the tonality
      * @param m the mode of the tonality
-     * @param s the scale of the tonality
+     * @param s the scale of the tonality, as the N_SCALE_NOTES intervals between its consecutive notes
+     */
+    Tonality(int t, int m, const int* s);
+
+    virtual ~Tonality() = default;
+
+    /**
+     * Returns the tonality with the given tonic and mode, shared by the whole process. The 24 major and minor
+     * tonalities are built once on first use, and this function is thread-safe. The returned tonality must not be
+     * deleted.
+     * @param tonic the tonic of the tonality
+     * @param mode the mode of the tonality (MAJOR_MODE or MINOR_MODE)
+     * @return the tonality with the given tonic and mode
      */
-    Tonality(int t, int m, vector<int> s);
+    static const Tonality* get_tonality(int tonic, int mode);
 
     /**
      * Get the name of the tonality
      * @return a string containing the name of the tonality
      */
-    string get_name() const;
+    const string& get_name() const { return name; }
 
     /**
      * Get the tonic of the tonality
      * @return the tonic of the tonality
      */
-    int get_tonic() const;
+    int get_tonic() const { return tonic; }
 
     /**
      * Get the mode of the tonality
      * @return the mode of the tonality
      */
-    int get_mode() const;
+    int get_mode() const { return mode; }
 
     /**
      * Get the scale of the tonality
-     * @return the scale of the tonality
+     * @return the N_SCALE_NOTES intervals between the consecutive notes of the scale
      */
-    vector<int> get_scale();
-
-    /**
-     * Get the notes corresponding to the degrees of the scale on which chords are built
-     * @return a map containing the notes for each of the scale degrees
-     */
-    map<int,int> get_degrees_notes();
+    const int* get_scale() const { return scale; }
 
     /**
      * Get the note on which the chord is built for a given degree
-     * @param degree the degree of the scale [0,6]
+     * @param degree the degree of the chord [0, N_DEGREES[
      * @return the note for the given degree
      */
-    int get_degree_note(int degree);
+    int get_degree_note(const int degree) const { return degrees_notes[degree]; }
 
     /**
-     * Get all the notes for each scale degree
-     * @return a map of [degree, all_notes] for each degree of the scale (0 to 6)
-     */
-    map<int, IntSet> get_scale_degrees();
-
-    /**
-     * Get all the notes for a given scale degree
-     * @param degree a degree of the scale [0,6]
-     * @return an IntSet containing all the notes for the given scale degree
+     * Get the default chord quality of a degree
+     * @param degree the degree of the chord [0, N_DEGREES[
+     * @return the default chord quality for the given degree
      */
-    IntSet get_scale_degree(int degree);
+    int get_chord_quality(const int degree) const { return chord_qualities[degree]; }
 
     /**
      * Get the notes that don't change in major or minor mode (1,4,5 degrees)
-     * @return an IntSet containing the tonal notes
+     * @return a mask of the tonal pitch classes (bit p set for pitch class p)
      */
-    set<int> get_tonal_notes();
+    int get_tonal_notes() const { return tonal_notes; }
 
     /**
      * Get the notes that change in major or minor mode (3,6,7 degrees)
-     * @return an IntSet containing the modal notes
+     * @return a mask of the modal pitch classes (bit p set for pitch class p)
      */
-    set<int> get_modal_notes();
+    int get_modal_notes() const { return modal_notes; }
 
     /**
-     * @return a string representing a tonality
+     * Returns whether a note is a tonal note (1,4,5 degrees)
+     * @param note a note
+     * @return true if the pitch class of the note is tonal
      */
-    string to_string();
-
-    string pretty();
-
-    /** ABSTRACT METHODS */
+    bool is_tonal_note(const int note) const { return (tonal_notes >> (note % PERFECT_OCTAVE) & 1) != 0; }
 
     /**
-     * Get the chord quality for each degree
-     * @param degree a degree of the scale [0,6]
-     * @return the default chord quality for the given degree
+     * @return a string representing a tonality
      */
-    virtual int get_chord_quality(int degree) = 0;
+    string to_string() const;
 
-    /**
-     * Get the chord notes for a given degree
-     * @param degree a degree of the scale [0,6]
-     * @return an IntSet containing the chord notes for the given degree
-     */
-    virtual IntSet get_scale_degree_chord(int degree) = 0;
+    string pretty() const;
 };
 
-#endif
\ No newline at end of file
+#endif
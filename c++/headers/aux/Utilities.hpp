@@ -8,6 +8,7 @@
 #include <fstream>
 #include <map>
 #include <set>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,30 @@ enum solver_types{
     LDS_SOLVER  //2
 };
 
+/** Variable selection heuristics for the branching on the voicing */
+enum variable_selection_heuristics{
+    RIGHT_TO_LEFT,  //0, last chord first, from the soprano to the bass
+    LEFT_TO_RIGHT,  //1, first chord first, from the bass to the soprano
+    DOM_SIZE_MIN,   //2
+    DEGREE_MAX,     //3
+    CHORD_COST_GUIDED   //4, last chord first, a whole chord at a time, cheapest voicing first (see ChordBrancher)
+};
+
+/** Value selection heuristics for the branching on the voicing */
+enum value_selection_heuristics{
+    VAL_RND,    //0
+    VAL_MIN,    //1
+    VAL_MAX,    //2
+    VAL_MED     //3
+};
+
+/** Neighbourhoods relaxed at each restart of the Large Neighbourhood Search */
+enum lns_neighbourhoods{
+    LNS_CHORD_WINDOW,       //0, all the voices of a window of consecutive chords
+    LNS_SINGLE_VOICE,       //1, a single voice over a (wider) window of consecutive chords
+    LNS_SECTION_BOUNDARY    //2, all the voices of a window of chords around the boundary between two sections
+};
+
 /** Voice ranges */
 constexpr int BASS_MIN = 40;
 constexpr int BASS_MAX = 60;
@@ -116,6 +141,9 @@ enum degrees{
     AUGMENTED_SIXTH,            //15
 };
 
+/// the number of degrees on which chords can be built
+constexpr int N_DEGREES = AUGMENTED_SIXTH + 1;
+
 const vector<std::string> degreeNames = {"I", "II", "III", "IV", "V", "VI", "VII",
                                          "Vda",
                                          "V/II", "V/III", "V/IV", "V/V", "V/VI",
@@ -174,38 +202,52 @@ const vector<std::string> chordQualityNames = {"Major", "Minor", "Diminished", "
                                                     "Diminished seventh", "Half diminished chord",
                                                     "Minor major seventh"};
 
-/// Types of chords represented by the intervals between their notes in root position up to an octave
-const vector<int> MAJOR_CHORD_INTERVALS                         = {MAJOR_THIRD, MINOR_THIRD};
-const vector<int> MINOR_CHORD_INTERVALS                         = {MINOR_THIRD, MAJOR_THIRD};
-const vector<int> DIMINISHED_CHORD_INTERVALS                    = {MINOR_THIRD, MINOR_THIRD};
-const vector<int> AUGMENTED_CHORD_INTERVALS                     = {MAJOR_THIRD, MAJOR_THIRD};
-const vector<int> AUGMENTED_SIXTH_CHORD_INTERVALS               = {MAJOR_THIRD, AUGMENTED_FOURTH};
-const vector<int> DOMINANT_SEVENTH_CHORD_INTERVALS              = {MAJOR_THIRD, MINOR_THIRD, MINOR_THIRD};
-const vector<int> MAJOR_SEVENTH_CHORD_INTERVALS                 = {MAJOR_THIRD, MINOR_THIRD, MAJOR_THIRD};
-const vector<int> MINOR_SEVENTH_CHORD_INTERVALS                 = {MINOR_THIRD, MAJOR_THIRD, MINOR_THIRD};
-const vector<int> DIMINISHED_SEVENTH_CHORD_INTERVALS            = {MINOR_THIRD, MINOR_THIRD, MINOR_THIRD};
-const vector<int> HALF_DIMINISHED_CHORD_INTERVALS               = {MINOR_THIRD, MINOR_THIRD, MAJOR_THIRD};
-const vector<int> MINOR_MAJOR_SEVENTH_CHORD_INTERVALS           = {MINOR_THIRD, MAJOR_THIRD, MAJOR_THIRD};
-/// todo There are three types of augmented sixth chords: Italian, French and German. For now, only italian is implemented
-const vector<int> MAJOR_NINTH_DOMINANT_CHORD_INTERVALS         = {MAJOR_THIRD, MINOR_THIRD, MINOR_THIRD, MAJOR_THIRD};
-const vector<int> MINOR_NINTH_DOMINANT_CHORD_INTERVALS         = {MAJOR_THIRD, MINOR_THIRD, MINOR_THIRD, MINOR_THIRD};
-
-const map<int, vector<int>> chordQualitiesIntervals = {
-        {MAJOR_CHORD,                   MAJOR_CHORD_INTERVALS},
-        {MINOR_CHORD,                   MINOR_CHORD_INTERVALS},
-        {DIMINISHED_CHORD,              DIMINISHED_CHORD_INTERVALS},
-        {AUGMENTED_CHORD,               AUGMENTED_CHORD_INTERVALS},
-        {AUGMENTED_SIXTH_CHORD,         AUGMENTED_SIXTH_CHORD_INTERVALS},
-        {DOMINANT_SEVENTH_CHORD,        DOMINANT_SEVENTH_CHORD_INTERVALS},
-        {MAJOR_SEVENTH_CHORD,           MAJOR_SEVENTH_CHORD_INTERVALS},
-        {MINOR_SEVENTH_CHORD,           MINOR_SEVENTH_CHORD_INTERVALS},
-        {DIMINISHED_SEVENTH_CHORD,      DIMINISHED_SEVENTH_CHORD_INTERVALS},
-        {HALF_DIMINISHED_CHORD,         HALF_DIMINISHED_CHORD_INTERVALS},
-        {MINOR_MAJOR_SEVENTH_CHORD,     MINOR_MAJOR_SEVENTH_CHORD_INTERVALS},
-        {MAJOR_NINTH_DOMINANT_CHORD,   MAJOR_NINTH_DOMINANT_CHORD_INTERVALS},
-        {MINOR_NINTH_DOMINANT_CHORD,   MINOR_NINTH_DOMINANT_CHORD_INTERVALS}
+/// the number of chord qualities
+constexpr int N_CHORD_QUALITIES = MINOR_NINTH_DOMINANT_CHORD + 1;
+/// the maximum number of intervals between consecutive notes of a chord (ninth chords)
+constexpr int MAX_CHORD_INTERVALS = 4;
+
+/// Types of chords represented by the intervals between their notes in root position up to an octave. The rows are
+/// padded with UNISON, see CHORD_QUALITIES_N_INTERVALS for the number of intervals of each quality
+constexpr int CHORD_QUALITIES_INTERVALS[N_CHORD_QUALITIES][MAX_CHORD_INTERVALS] = {
+    {MAJOR_THIRD, MINOR_THIRD},                                 // MAJOR_CHORD
+    {MINOR_THIRD, MAJOR_THIRD},                                 // MINOR_CHORD
+    {MINOR_THIRD, MINOR_THIRD},                                 // DIMINISHED_CHORD
+    {MAJOR_THIRD, MAJOR_THIRD},                                 // AUGMENTED_CHORD
+    {MAJOR_THIRD, AUGMENTED_FOURTH},                            // AUGMENTED_SIXTH_CHORD
+    {MAJOR_THIRD, MINOR_THIRD, MINOR_THIRD},                    // DOMINANT_SEVENTH_CHORD
+    {MAJOR_THIRD, MINOR_THIRD, MAJOR_THIRD},                    // MAJOR_SEVENTH_CHORD
+    {MINOR_THIRD, MAJOR_THIRD, MINOR_THIRD},                    // MINOR_SEVENTH_CHORD
+    {MINOR_THIRD, MINOR_THIRD, MINOR_THIRD},                    // DIMINISHED_SEVENTH_CHORD
+    {MINOR_THIRD, MINOR_THIRD, MAJOR_THIRD},                    // HALF_DIMINISHED_CHORD
+    {MINOR_THIRD, MAJOR_THIRD, MAJOR_THIRD},                    // MINOR_MAJOR_SEVENTH_CHORD
+    /// todo There are three types of augmented sixth chords: Italian, French and German. For now, only italian is implemented
+    {MAJOR_THIRD, MINOR_THIRD, MINOR_THIRD, MAJOR_THIRD},       // MAJOR_NINTH_DOMINANT_CHORD
+    {MAJOR_THIRD, MINOR_THIRD, MINOR_THIRD, MINOR_THIRD}        // MINOR_NINTH_DOMINANT_CHORD
 };
 
+/// the number of intervals between consecutive notes of each chord quality
+constexpr int CHORD_QUALITIES_N_INTERVALS[N_CHORD_QUALITIES] = {2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4};
+
+/**
+ * Checks that a chord quality exists
+ * @param quality the quality of the chord
+ * @return the quality if it exists, throws std::invalid_argument otherwise
+ */
+constexpr int checked_chord_quality(const int quality) {
+    return quality >= 0 && quality < N_CHORD_QUALITIES ? quality :
+        throw std::invalid_argument("Unknown chord quality: " + std::to_string(quality));
+}
+
+/**
+ * Returns the number of notes of a chord, regardless of their octave
+ * @param quality the quality of the chord
+ * @return the number of different notes in a complete chord of this quality
+ */
+constexpr int get_number_of_notes_in_chord(const int quality) {
+    return CHORD_QUALITIES_N_INTERVALS[checked_chord_quality(quality)] + 1;
+}
+
 // Chord states
 enum chordStates{
     FUNDAMENTAL_STATE,  //0
@@ -247,10 +289,13 @@ const vector<std::string> modeNames = {"Major", "Dorian", "Phrygian", "Lydian",
 
 //@todo turn this into a dictionary with the name of the scale as key and the vector of intervals as value
 
-const vector<int> MAJOR_SCALE = {MAJOR_SECOND, MAJOR_SECOND, MINOR_SECOND, MAJOR_SECOND, MAJOR_SECOND, MAJOR_SECOND, MINOR_SECOND};
-const vector<int> NATURAL_MINOR_SCALE = {MAJOR_SECOND, MINOR_SECOND, MAJOR_SECOND, MAJOR_SECOND, MINOR_SECOND, MAJOR_SECOND, MAJOR_SECOND};
-const vector<int> HARMONIC_MINOR_SCALE = {MAJOR_SECOND, MINOR_SECOND, MAJOR_SECOND, MAJOR_SECOND, MINOR_SECOND, AUGMENTED_SECOND, MINOR_SECOND};
-const vector<int> MELODIC_MINOR_SCALE = {MAJOR_SECOND, MINOR_SECOND, MAJOR_SECOND, MAJOR_SECOND, MAJOR_SECOND, MAJOR_SECOND, MINOR_SECOND};
+/// the number of notes in a scale
+constexpr int N_SCALE_NOTES = 7;
+
+constexpr int MAJOR_SCALE[N_SCALE_NOTES] = {MAJOR_SECOND, MAJOR_SECOND, MINOR_SECOND, MAJOR_SECOND, MAJOR_SECOND, MAJOR_SECOND, MINOR_SECOND};
+constexpr int NATURAL_MINOR_SCALE[N_SCALE_NOTES] = {MAJOR_SECOND, MINOR_SECOND, MAJOR_SECOND, MAJOR_SECOND, MINOR_SECOND, MAJOR_SECOND, MAJOR_SECOND};
+constexpr int HARMONIC_MINOR_SCALE[N_SCALE_NOTES] = {MAJOR_SECOND, MINOR_SECOND, MAJOR_SECOND, MAJOR_SECOND, MINOR_SECOND, AUGMENTED_SECOND, MINOR_SECOND};
+constexpr int MELODIC_MINOR_SCALE[N_SCALE_NOTES] = {MAJOR_SECOND, MINOR_SECOND, MAJOR_SECOND, MAJOR_SECOND, MAJOR_SECOND, MAJOR_SECOND, MINOR_SECOND};
 
 /** Modulations */
 enum modulations{
@@ -288,13 +333,44 @@ vector<int> get_all_notes_in_chord(int root, int quality);
  */
 vector<int> get_all_given_note(int note);
 
+/// the number of sets of pitch classes, each pitch class being a bit of a mask
+const int N_PITCH_CLASS_MASKS = 1 << PERFECT_OCTAVE;
+
 /**
- * Get the interval in semitones between the root and
+ * Get the interval in semitones between the root and a note of a chord. It is computed at compile time when the
+ * arguments are constants.
  * @param quality the quality of the chord
  * @param chordNote the rank of the note in the chord (fundamental, third, fifth, etc.)
  * @return the interval in semitones between the root and the note
  */
-int get_interval_from_root(int quality, int chordNote);
+constexpr int get_interval_from_root(const int quality, const int chordNote) {
+    return chordNote <= ROOT ? 0 : get_interval_from_root(quality, chordNote - 1) +
+        CHORD_QUALITIES_INTERVALS[checked_chord_quality(quality)][chordNote - 1];
+}
+
+/**
+ * Returns the pitch classes of the notes of a chord from a given rank as a mask (see get_chord_pitch_class_mask)
+ * @param root the root of the chord in [0,11]
+ * @param quality the quality of the chord
+ * @param chordNote the rank of the first note in the mask
+ * @return the mask of the pitch classes of the notes of rank chordNote and above
+ */
+constexpr int chord_pitch_class_mask_from(const int root, const int quality, const int chordNote) {
+    return chordNote > CHORD_QUALITIES_N_INTERVALS[checked_chord_quality(quality)] ? 0 :
+        (1 << ((root + get_interval_from_root(quality, chordNote)) % PERFECT_OCTAVE)) |
+        chord_pitch_class_mask_from(root, quality, chordNote + 1);
+}
+
+/**
+ * Returns the pitch classes of a chord as a mask (bit p set for pitch class p). It is computed at compile time when
+ * the arguments are constants.
+ * @param root the root of the chord
+ * @param quality the quality of the chord
+ * @return the mask of the pitch classes of the chord
+ */
+constexpr int get_chord_pitch_class_mask(const int root, const int quality) {
+    return chord_pitch_class_mask_from(root % PERFECT_OCTAVE, quality, ROOT);
+}
 
 /**
  * Transforms an int* into a vector<int>
@@ -0,0 +1,120 @@
+#ifndef BATCHSOLVER_HPP
+#define BATCHSOLVER_HPP
+
+#include <functional>
+
+#include "CancellableStop.hpp"
+#include "FourVoiceTextureParameters.hpp"
+#include "DiatonySolution.hpp"
+#include "../aux/Utilities.hpp"
+
+/** The status of a job of a batch */
+enum batch_job_status {
+    JOB_SOLVED,         //0, a solution was found within the time budget of the job
+    JOB_NO_SOLUTION,    //1, no solution was found within the time budget of the job
+    JOB_INVALID,        //2, the parameters were rejected (see check_parameters)
+    JOB_EXPIRED,        //3, the deadline of the batch was reached before the job started
+    JOB_ERROR,          //4, the search failed for another reason (e.g. out of memory)
+    JOB_CANCELLED       //5, the batch was cancelled. The solution is the best one found before, if any.
+};
+
+/// the name of each status (see batch_job_status)
+extern const vector<string> batch_job_status_names;
+
+/**
+ * A problem to solve in a batch
+ */
+struct BatchJob {
+    int                             id;                 // reported with the result of the job
+    FourVoiceTextureParameters*     params;             // the parameters of the problem (not owned)
+    double                          timeLimit;          // the time budget in milliseconds, negative for the default one
+    int                             variableSelection;  // see variable_selection_heuristics
+    int                             valueSelection;     // see value_selection_heuristics
+
+    /**
+     * Constructor
+     * @param id the identifier of the job, reported with its result
+     * @param params the parameters of the problem. They must outlive the batch.
+     * @param timeLimit the time budget of the job in milliseconds, or a negative value for the default budget
+     * @param variableSelection the variable selection heuristic (see variable_selection_heuristics)
+     * @param valueSelection the value selection heuristic (see value_selection_heuristics)
+     */
+    BatchJob(const int id, FourVoiceTextureParameters* params, const double timeLimit = -1,
+             const int variableSelection = RIGHT_TO_LEFT, const int valueSelection = VAL_RND) :
+        id(id), params(params), timeLimit(timeLimit), variableSelection(variableSelection),
+        valueSelection(valueSelection) {}
+};
+
+/**
+ * The result of a job of a batch. It can be moved but not copied.
+ */
+struct BatchResult {
+    int                 id;             // the id of the job
+    int                 status;         // see batch_job_status
+    DiatonySolution     solution;       // the best solution found, if the status is JOB_SOLVED or JOB_CANCELLED
+    double              time;           // the time spent on the job in milliseconds
+    string              error;          // the reason of the failure if the status is JOB_INVALID or JOB_ERROR
+};
+
+/**
+ * This class solves many Four voice texture problems inside a single process, on a pool of worker threads. The jobs are
+ * dealt to the workers in contiguous blocks, and a worker whose block is empty steals the last job of another worker,
+ * so that a few long jobs do not leave the other threads idle. Each job is solved with solve_diatony on its own thread,
+ * under its time budget, capped by the time left before the deadline of the batch. Jobs that have not started when the
+ * deadline is reached are reported as expired. The batch can be cancelled from another thread with a CancellableStop,
+ * whose limits then apply to each job on top of its time budget. The tonalities and the other theory tables are shared
+ * by all the jobs.
+ */
+class BatchSolver {
+protected:
+    unsigned int    nWorkers;               // the number of worker threads
+    double          defaultTimeLimit;       // the time budget of the jobs that do not have one, in milliseconds
+    double          deadline;               // the time limit of the whole batch in milliseconds, negative if none
+
+    /**
+     * Solves the jobs on the pool of workers
+     * @param jobs the problems to solve
+     * @param onResult called with the index of each job and its result, never by two threads at the same time
+     * @param stop stops the jobs when it is cancelled or one of its limits is reached (can be nullptr)
+     */
+    void run(const vector<BatchJob>& jobs, const std::function<void(int, BatchResult&&)>& onResult,
+             CancellableStop* stop) const;
+
+public:
+    /**
+     * Constructor
+     * @param nWorkers the number of worker threads. If it is 0, one worker per hardware thread is used.
+     * @param defaultTimeLimit the time budget of the jobs that do not have one, in milliseconds
+     * @param deadline the time limit of the whole batch in milliseconds, or a negative value if there is none
+     */
+    explicit BatchSolver(unsigned int nWorkers = 0, double defaultTimeLimit = 60000, double deadline = -1);
+
+    /**
+     * Solves the jobs and reports their results as soon as they finish, in the order in which they finish. The
+     * callback is never called by two threads at the same time. This function returns when all the jobs are reported.
+     * @param jobs the problems to solve
+     * @param onResult called with the result of each job
+     * @param stop stops the jobs when it is cancelled or one of its limits is reached (can be nullptr). Once it is
+     * cancelled, the jobs that have not started are reported as cancelled.
+     */
+    void solve(const vector<BatchJob>& jobs, const std::function<void(const BatchResult&)>& onResult,
+               CancellableStop* stop = nullptr) const;
+
+    /**
+     * Solves the jobs and returns their results
+     * @param jobs the problems to solve
+     * @param stop stops the jobs when it is cancelled or one of its limits is reached (can be nullptr). Once it is
+     * cancelled, the jobs that have not started are reported as cancelled.
+     * @return the results of the jobs, in the order of the jobs
+     */
+    vector<BatchResult> solve(const vector<BatchJob>& jobs, CancellableStop* stop = nullptr) const;
+
+    /**                 getters                      **/
+    unsigned int get_number_of_workers() const { return nWorkers; }
+
+    double get_default_time_limit() const { return defaultTimeLimit; }
+
+    double get_deadline() const { return deadline; }
+};
+
+#endif //BATCHSOLVER_HPP
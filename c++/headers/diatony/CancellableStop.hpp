@@ -0,0 +1,97 @@
+#ifndef CANCELLABLESTOP_HPP
+#define CANCELLABLESTOP_HPP
+
+#include <atomic>
+#include <chrono>
+
+#include "../aux/Utilities.hpp"
+
+/**
+ * This class is a stop object that can be cancelled from any thread, combined with any number of limits (nodes,
+ * failures, time, memory, or any other stop object). The search stops as soon as it is cancelled or one of its limits
+ * is reached, which the engines check at every node. The limits must be added before the search starts, but the
+ * object can then be cancelled at any time and shared by the threads of a parallel search (e.g. a portfolio).
+ */
+class CancellableStop : public Search::Stop {
+protected:
+    std::atomic<bool>       cancelled;
+    vector<Search::Stop*>   limits;         // the limits combined with the cancellation, owned by this object
+    std::chrono::steady_clock::time_point deadline;     // the end of the earliest time limit, max() if there is none
+
+public:
+    /**
+     * Constructor for a stop object without limits. The search only stops when it is cancelled.
+     */
+    CancellableStop() : cancelled(false), deadline(std::chrono::steady_clock::time_point::max()) {}
+
+    /**
+     * Constructor for a stop object with a time limit
+     * @param timeLimit the time limit in milliseconds, counted from the construction of the object
+     */
+    explicit CancellableStop(double timeLimit);
+
+    CancellableStop(const CancellableStop&) = delete;
+
+    CancellableStop& operator=(const CancellableStop&) = delete;
+
+    ~CancellableStop() override;
+
+    /**
+     * Adds a limit to the search
+     * @param limit a stop object, which is deleted with this object
+     * @return this object
+     */
+    CancellableStop& add(Search::Stop* limit);
+
+    /**
+     * Adds a limit on the number of nodes explored by each engine
+     * @param nodes the maximum number of nodes
+     * @return this object
+     */
+    CancellableStop& node_limit(unsigned long nodes) { return add(Search::Stop::node(nodes)); }
+
+    /**
+     * Adds a limit on the number of failures of each engine
+     * @param fails the maximum number of failures
+     * @return this object
+     */
+    CancellableStop& fail_limit(unsigned long fails) { return add(Search::Stop::fail(fails)); }
+
+    /**
+     * Adds a time limit
+     * @param timeLimit the time limit in milliseconds, counted from now
+     * @return this object
+     */
+    CancellableStop& time_limit(double timeLimit);
+
+    /**
+     * Adds a limit on the memory used by the process. The peak resident set size of the process is measured, so the
+     * search stops once it exceeded the limit, even if the memory has been released since.
+     * @param bytes the maximum resident set size of the process in bytes
+     * @return this object
+     */
+    CancellableStop& memory_limit(size_t bytes);
+
+    /**
+     * Cancels the search. It can be called from any thread, and the engines stop at the next node they explore.
+     */
+    void cancel() { cancelled.store(true); }
+
+    /**
+     * @return the time left before the earliest time limit in milliseconds (negative once it is reached), or infinity
+     * if there is no time limit
+     */
+    double remaining_time() const;
+
+    /**
+     * @return true if the search was cancelled
+     */
+    bool is_cancelled() const { return cancelled.load(); }
+
+    /**
+     * @return true if the search was cancelled or one of its limits was reached
+     */
+    bool stop(const Search::Statistics& s, const Search::Options& o) override;
+};
+
+#endif //CANCELLABLESTOP_HPP
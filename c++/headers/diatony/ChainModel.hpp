@@ -0,0 +1,198 @@
+#ifndef CHAINMODEL_HPP
+#define CHAINMODEL_HPP
+
+#include <array>
+
+#include "../aux/Utilities.hpp"
+#include "../aux/Tonality.hpp"
+#include "TonalProgressionParameters.hpp"
+
+/// The number of costs in the cost vector of the problem
+constexpr int N_COSTS = 5;
+
+/// The notes of a chord for each voice [bass, tenor, alto, soprano]
+typedef std::array<int, 4> ChordVoicing;
+
+/// The costs of a (partial) solution in lexicographical order, in the same order as the cost vector of FourVoiceTexture:
+/// {nOfIncompleteChords, nOfFundStateDiminishedChordsWith4notes, nOfChordsWithLessThan4Values, costOfMelodicIntervals,
+/// nOfCommonNotesInSameVoice (negative)}. std::array compares lexicographically, and costs are additive.
+typedef std::array<int, N_COSTS> CostVector;
+
+/** Variants of a chord, for the rules that depend on the position of the chord in the progression */
+enum chord_variants{
+    DEFAULT_VARIANT,                //0
+    AFTER_FIFTH_DEGREE_VARIANT,     //1, sixth degree in fundamental state after a fifth degree (third doubled)
+    INTERIOR_CHORD_VARIANT          //2, first inversion chord that is neither the first nor the last chord
+};
+
+/**
+ * This class is a pure C++ representation of the rules of a single tonal progression, mirroring the constraints posted
+ * by TonalProgression and FourVoiceTexture for a piece with a single section. All the rules relate either a single
+ * chord or two consecutive chords, except for the doubling in interior first inversion chords which depends on the
+ * motion of the bass and soprano around the chord (see is_motion_dependent). The legal voicings of each chord are
+ * enumerated once, so that the problem can be solved without Gecode (see ChainSolver).
+ */
+class ChainModel {
+protected:
+    int                                 nVoices = 4;
+    TonalProgressionParameters*         params;                 // the parameters of the progression
+    const Tonality*                     tonality;               // the tonality of the progression
+    int                                 size;                   // the number of chords
+    IntSpan                             degrees;                // the degrees of the chords (view on params)
+    IntSpan                             qualities;              // the qualities of the chords (view on params)
+    IntSpan                             states;                 // the states of the chords (view on params)
+
+    vector<vector<ChordVoicing>>        voicings;               // the legal voicings of each chord
+    vector<vector<CostVector>>          chordCosts;             // the cost of each legal voicing of each chord
+    vector<bool>                        motionDependent;        // whether the doubling of the chord depends on the motion around it
+    vector<int>                         thirds;                 // the third of each chord (as a note in [0,11])
+
+    /// rules between chord i and chord i+1
+    vector<int>                         transitionRules;        // the special rule applying to the transition (see transition_rules)
+    vector<bool>                        tritoneResolution;      // whether the tritone must be resolved
+    vector<int>                         preparedSeventh;        // the seventh of chord i+1 that must be prepared, -1 if none
+    vector<bool>                        contraryMotion;         // whether the upper voices move in contrary motion to the bass
+    vector<bool>                        appoggiaturaApproach;   // whether chord i+1 is an appoggiatura that must be approached properly
+
+    /** Special rules applying to a transition, in the order in which they are checked by TonalProgression */
+    enum transition_rules{
+        GENERAL_RULES,              //0
+        INTERRUPTED_CADENCE_RULES,  //1
+        ITALIAN_SIXTH_RULES,        //2
+        APPOGGIATURA_RULES          //3
+    };
+
+    /**
+     * Checks the tritone resolution rules between two chords
+     * @param i the position of the first chord
+     * @param current the voicing of the first chord
+     * @param next the voicing of the second chord
+     * @return true if the rules are respected, false otherwise
+     */
+    bool respects_tritone_resolution(int i, const ChordVoicing& current, const ChordVoicing& next) const;
+
+    /**
+     * Checks the special rules of the transition (interrupted cadence, augmented sixth, appoggiatura, or the general
+     * voice leading rules)
+     * @param i the position of the first chord
+     * @param current the voicing of the first chord
+     * @param next the voicing of the second chord
+     * @return true if the rules are respected, false otherwise
+     */
+    bool respects_transition_rules(int i, const ChordVoicing& current, const ChordVoicing& next) const;
+
+public:
+    /**
+     * Constructor. Enumerates the legal voicings of each chord.
+     * @param params the parameters of the progression
+     */
+    explicit ChainModel(TonalProgressionParameters* params);
+
+    /**                     getters                     **/
+    int get_size() const { return size; }
+
+    TonalProgressionParameters* get_parameters() const { return params; }
+
+    const vector<ChordVoicing>& get_voicings(const int chord) const { return voicings[chord]; }
+
+    const CostVector& get_chord_cost(const int chord, const int voicing) const { return chordCosts[chord][voicing]; }
+
+    /**
+     * Returns whether the doubling of a chord depends on the motion of the bass and soprano before and after it. This
+     * is the case for interior first inversion chords: the third is doubled if and only if the bass rises and the
+     * soprano falls by step on both sides of the chord, so that these chords need to know how they were approached.
+     * @param chord the position of the chord
+     * @return true if the doubling of the chord depends on the motion around it
+     */
+    bool is_motion_dependent(const int chord) const { return motionDependent[chord]; }
+
+    /**
+     * Returns the number of times the third of a chord is present in one of its voicings
+     * @param chord the position of the chord
+     * @param voicing the voicing of the chord
+     * @return the number of voices playing the third of the chord
+     */
+    int count_thirds(int chord, const ChordVoicing& voicing) const;
+
+    /**
+     * Checks all the rules between two consecutive chords, except the doubling of motion dependent chords
+     * @param i the position of the first chord
+     * @param current the voicing of chord i
+     * @param next the voicing of chord i+1
+     * @return true if the transition is legal, false otherwise
+     */
+    bool is_legal_transition(int i, const ChordVoicing& current, const ChordVoicing& next) const;
+
+    /**
+     * Returns the cost of moving from a voicing to the next one (melodic intervals and common notes)
+     * @param current the voicing of the first chord
+     * @param next the voicing of the second chord
+     * @return the costs of the transition
+     */
+    static CostVector transition_cost(const ChordVoicing& current, const ChordVoicing& next);
+
+    /**
+     * Returns the costs of a voicing of a chord (incomplete chord, diminished chord with 4 notes, less than 4 values)
+     * @param quality the quality of the chord
+     * @param state the state of the chord
+     * @param voicing the voicing of the chord
+     * @return the costs of the chord
+     */
+    static CostVector chord_cost(int quality, int state, const ChordVoicing& voicing);
+
+    /**
+     * Returns whether the bass rises and the soprano falls by step between two voicings
+     * @param current the voicing of the first chord
+     * @param next the voicing of the second chord
+     * @return true if the bass rises by step and the soprano falls by step
+     */
+    static bool stepwise_contrary_motion(const ChordVoicing& current, const ChordVoicing& next);
+
+    /**
+     * Returns the variant of a chord, that is the information about its neighbours that the rules on its own notes
+     * depend on
+     * @param params the parameters of the progression
+     * @param chord the position of the chord
+     * @return the variant of the chord (see chord_variants)
+     */
+    static int chord_variant(const TonalProgressionParameters* params, int chord);
+
+    /**
+     * Returns whether the doubling of a first inversion chord is decided by the motion of the bass and the soprano, that
+     * is when its third is not doubled by a fixed rule (see double_third_on_contrary_motion)
+     * @param tonality the tonality of the chord
+     * @param degree the degree of the chord
+     * @param quality the quality of the chord
+     * @return true if the default doubling rule applies
+     */
+    static bool default_first_inversion_doubling(const Tonality* tonality, int degree, int quality);
+
+    /**
+     * Enumerates all the voicings of a chord respecting the voice ranges, the order of the voices, the bass of the
+     * chord and the note occurrence rules.
+     * @param tonality the tonality of the chord
+     * @param degree the degree of the chord
+     * @param quality the quality of the chord
+     * @param state the state of the chord
+     * @param variant the variant of the chord (see chord_variants)
+     * @return the legal voicings of the chord, by increasing bass, tenor, alto and soprano
+     */
+    static vector<ChordVoicing> enumerate_voicings(const Tonality* tonality, int degree, int quality, int state,
+                                                   int variant);
+
+    /**
+     * Checks the note occurrence rules of a chord (which notes must be present, doubled, etc.). This is the only
+     * definition of these rules: the voicing tables of the model are enumerated with it (see get_chord_voicing_table).
+     * @param tonality the tonality of the chord
+     * @param degree the degree of the chord
+     * @param quality the quality of the chord
+     * @param state the state of the chord
+     * @param variant the variant of the chord (see chord_variants)
+     * @param voicing the voicing of the chord
+     * @return true if the rules are respected, false otherwise
+     */
+    static bool respects_note_occurrences(const Tonality* tonality, int degree, int quality, int state, int variant,
+                                          const ChordVoicing& voicing);
+};
+
+#endif //CHAINMODEL_HPP
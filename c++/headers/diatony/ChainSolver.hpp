@@ -0,0 +1,60 @@
+#ifndef CHAINSOLVER_HPP
+#define CHAINSOLVER_HPP
+
+#include "ChainModel.hpp"
+#include "FourVoiceTextureParameters.hpp"
+
+/**
+ * This class solves a single tonal progression exactly without Gecode. Since all the rules of the progression relate
+ * at most two consecutive chords (see ChainModel) and the costs are sums of per-chord and per-transition terms, the
+ * optimal voicing is found with a Viterbi-style dynamic programming over the legal voicings of each chord, comparing
+ * costs lexicographically. Ties are broken in favour of the first voicing enumerated, so the result is deterministic.
+ * With a beam width, only the best states of each chord are expanded: the search is then a fast heuristic that may miss
+ * the optimum, or even fail to find a solution, but evaluates a number of transitions linear in the number of chords.
+ */
+class ChainSolver {
+protected:
+    const ChainModel&               model;                  // the rules of the progression
+    vector<int>                     voicing;                // the optimal voicing [bass0, tenor0, alto0, soprano0, bass1, ...]
+    CostVector                      costs;                  // the costs of the optimal voicing
+    bool                            solved = false;         // whether an optimal voicing was found
+    long                            nTransitions = 0;       // the number of transitions evaluated
+
+public:
+    /**
+     * Constructor
+     * @param model the rules of the progression to solve. It must outlive the solver.
+     */
+    explicit ChainSolver(const ChainModel& model) : model(model) {}
+
+    /**
+     * Finds an optimal voicing of the progression
+     * @param beamWidth the maximum number of states kept for each chord, 0 to keep all of them (exact search)
+     * @return true if a voicing was found, false otherwise (the progression has no solution if beamWidth is 0)
+     */
+    bool solve(int beamWidth = 0);
+
+    /**                     getters                     **/
+    bool is_solved() const { return solved; }
+
+    const vector<int>& get_voicing() const { return voicing; }
+
+    vector<int> get_cost_values() const { return vector<int>(costs.begin(), costs.end()); }
+
+    long get_number_of_transitions() const { return nTransitions; }
+};
+
+/**
+ * Returns the optimal voicing of a piece containing a single section, using the chain dynamic programming solver.
+ * @param params the parameters of the problem. It must contain exactly one section.
+ * @param voicing the vector in which the optimal voicing is written
+ * @param costs the vector in which the costs of the optimal voicing are written, in the order of the cost vector of
+ * FourVoiceTexture
+ * @param print whether to print the solution and the time taken
+ * @param beamWidth the maximum number of states kept for each chord, 0 for an exact search (see ChainSolver::solve)
+ * @return true if a solution was found, false if the problem has no solution (or if the beam search found none)
+ */
+bool solve_diatony_chain(const FourVoiceTextureParameters* params, vector<int>& voicing, vector<int>& costs,
+                         bool print = false, int beamWidth = 0);
+
+#endif //CHAINSOLVER_HPP
@@ -0,0 +1,20 @@
+#ifndef CHORDBRANCHER_HPP
+#define CHORDBRANCHER_HPP
+
+#include "../aux/Utilities.hpp"
+#include "FourVoiceTextureParameters.hpp"
+
+/**
+ * Posts a brancher that assigns a whole chord in each decision. Chords are selected from the last one to the first one,
+ * like the RIGHT_TO_LEFT heuristic. The candidate voicings of the selected chord (the combinations of the values left in
+ * the domains of its voices, in increasing order) are tried in increasing lexicographical order of the cost they add
+ * to the cost vector: the costs of the chord itself and the costs of the transitions with its neighbours that are
+ * already assigned. The first solutions are then close to optimal, which speeds up branch and bound.
+ * @param home the instance of the problem
+ * @param fullVoicing the voicing of the whole piece [bass0, tenor0, alto0, soprano0, bass1, ...]
+ * @param params the parameters of the piece, used to get the quality and state of each chord. They must outlive the
+ * space.
+ */
+void chord_branch(Home home, const IntVarArray& fullVoicing, const FourVoiceTextureParameters* params);
+
+#endif //CHORDBRANCHER_HPP
@@ -0,0 +1,32 @@
+#ifndef CHORDVOICINGTABLES_HPP
+#define CHORDVOICINGTABLES_HPP
+
+#include "ChainModel.hpp"
+
+/** Columns of a chord voicing table */
+enum chord_table_columns{
+    TABLE_BASS,                     //0
+    TABLE_TENOR,                    //1
+    TABLE_ALTO,                     //2
+    TABLE_SOPRANO,                  //3
+    TABLE_N_DIFFERENT_NOTES,        //4, the number of different notes regardless of their octave
+    TABLE_N_DIMINISHED_VALUES,      //5, the number of different values for fundamental state diminished chords, 0 otherwise
+    CHORD_TABLE_ARITY               //6
+};
+
+/**
+ * Returns the table of all the legal voicings of a chord, that is the voicings respecting the voice ranges, the order
+ * of the voices, the bass of the chord and its note occurrence rules (see ChainModel::enumerate_voicings). Each tuple
+ * also contains the values of the cost-related variables of the chord (see chord_table_columns), so that a single
+ * extensional constraint replaces the domain, count and nvalues constraints of the chord.
+ * The tables are built once per process on first use and shared by all the spaces. This function is thread-safe.
+ * @param tonality the tonality of the chord
+ * @param degree the degree of the chord
+ * @param quality the quality of the chord
+ * @param state the state of the chord
+ * @param variant the variant of the chord (see chord_variants)
+ * @return the table of the legal voicings of the chord
+ */
+const TupleSet& get_chord_voicing_table(const Tonality* tonality, int degree, int quality, int state, int variant);
+
+#endif //CHORDVOICINGTABLES_HPP
@@ -0,0 +1,119 @@
+#ifndef CONSTRAINTREGISTRY_HPP
+#define CONSTRAINTREGISTRY_HPP
+
+#include <set>
+#include <tuple>
+#include <functional>
+
+#include "../aux/Utilities.hpp"
+#include "RulePosting.hpp"
+
+/// The families of rules posted through the ConstraintRegistry
+enum rule_families {
+    PARALLEL_INTERVALS_RULE,        // 0
+    TRITONE_RESOLUTION_RULE,        // 1
+    INTERRUPTED_CADENCE_RULE,       // 2
+    ITALIAN_AUGMENTED_SIXTH_RULE,   // 3
+    FIFTH_DEGREE_APPOGIATURA_RULE,  // 4
+    SPECIES_SEVENTH_RULE,           // 5
+    CONTRARY_MOTION_RULE,           // 6
+    CHORD_VOICING_RULE,             // 7
+    DOUBLE_THIRD_RULE,              // 8
+    CHROMATIC_MODULATION_RULE,      // 9
+    N_RULE_FAMILIES                 // 10
+};
+
+/// the name of each rule family (see rule_families)
+extern const vector<string> rule_family_names;
+
+/**
+ * Registry used while constructing a FourVoiceTexture space. Rules are posted through it with a key made of their
+ * family, their absolute position in the piece and the pair of voices they constrain (ALL_VOICES if the rule is on all
+ * voices). A rule whose key was already posted is rejected, so that a rule posted both for the whole piece and by a
+ * section is only posted once, and the number of propagators stays linear in the number of chords.
+ * The registry also counts, for each family, the rules posted, the duplicates rejected and the propagators created,
+ * which are reported by to_string.
+ * Chord-level rules are legitimately posted twice on a pivot chord (once for each tonality), so they are posted with
+ * count, which only keeps the statistics.
+ * The registry holds the literals of the rules (see RuleLiterals), so that a literal on a note (e.g. "the soprano plays
+ * the leading tone") is created once for the whole space and shared by all the rules that use it.
+ * An object of this class must only be used while posting the constraints of a space.
+ */
+class ConstraintRegistry {
+protected:
+    /// (family, position, first voice, second voice)
+    typedef std::tuple<int, int, int, int> RuleKey;
+
+    Home                    home;
+    std::set<RuleKey>       posted;
+    vector<int>             nRules;                     // the number of rules posted in each family
+    vector<int>             nDuplicates;                // the number of rules rejected in each family
+    vector<unsigned int>    nPropagators;               // the number of propagators created by each family
+    RuleLiterals            literals;                   // the literals shared by all the rules of the space
+
+    /**
+     * Posts a rule and adds the propagators it created to its family
+     * @param family the family of the rule (see rule_families)
+     * @param rule posts the constraints of the rule
+     */
+    void post_rule(int family, const std::function<void()>& rule);
+
+public:
+    /// the voices of rules constraining all voices
+    static const int ALL_VOICES = -1;
+
+    /**
+     * Constructor
+     * @param home the space in which the rules are posted
+     */
+    explicit ConstraintRegistry(Home home);
+
+    /**
+     * Posts a rule on a pair of voices unless a rule with the same family, position and voices has already been posted
+     * @param family the family of the rule (see rule_families)
+     * @param position the absolute position of the rule in the piece
+     * @param voice1 the first voice constrained by the rule, or ALL_VOICES
+     * @param voice2 the second voice constrained by the rule, or ALL_VOICES
+     * @param rule posts the constraints of the rule
+     * @return true if the rule was posted, false if it was a duplicate
+     */
+    bool post(int family, int position, int voice1, int voice2, const std::function<void()>& rule);
+
+    /**
+     * Posts a rule on all voices unless a rule with the same family and position has already been posted
+     * @param family the family of the rule (see rule_families)
+     * @param position the absolute position of the rule in the piece
+     * @param rule posts the constraints of the rule
+     * @return true if the rule was posted, false if it was a duplicate
+     */
+    bool post(const int family, const int position, const std::function<void()>& rule) {
+        return post(family, position, ALL_VOICES, ALL_VOICES, rule);
+    }
+
+    /**
+     * Posts a rule without checking for duplicates, only keeping the statistics of its family
+     * @param family the family of the rule (see rule_families)
+     * @param rule posts the constraints of the rule
+     */
+    void count(int family, const std::function<void()>& rule);
+
+    /**
+     * @return the literals shared by all the rules posted in the space
+     */
+    RuleLiterals& get_literals() { return literals; }
+
+    /**                 getters                      **/
+    int get_number_of_rules(const int family) const { return nRules[family]; }
+
+    int get_number_of_duplicates(const int family) const { return nDuplicates[family]; }
+
+    unsigned int get_number_of_propagators(const int family) const { return nPropagators[family]; }
+
+    /**
+     * to_string method
+     * @return a line per family with the number of rules posted, rejected and the propagators created
+     */
+    string to_string() const;
+};
+
+#endif //CONSTRAINTREGISTRY_HPP
@@ -0,0 +1,123 @@
+/*
+ * C interface of the diatony library. Only C types cross this interface: the problems are given as flat int arrays
+ * using the values of the enums of Utilities.hpp (degrees, chordTypes, chordStates, Mode, modulations), and the
+ * solutions are written into buffers provided by the caller. No function allocates memory that the caller must free,
+ * and no exception crosses the interface.
+ */
+
+#ifndef DIATONYCAPI_H
+#define DIATONYCAPI_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The version of this interface. It changes only when existing functions change. */
+#define DIATONY_API_VERSION 1
+
+/** The status returned by the solve functions */
+typedef enum {
+    DIATONY_SOLVED = 0,             /* the best solution found within the time limit was written */
+    DIATONY_NO_SOLUTION = 1,        /* no solution was found within the time limit */
+    DIATONY_INVALID = 2,            /* the problem was rejected, see diatony_last_error */
+    DIATONY_BUFFER_TOO_SMALL = 3,   /* a buffer is too small for the solution, see the required sizes */
+    DIATONY_ERROR = 4,              /* an unexpected error occurred, see diatony_last_error */
+    DIATONY_CANCELLED = 5           /* the search was cancelled, the best solution found before was written if any */
+} diatony_status;
+
+/**
+ * A solver handle. It owns the solution cache and the number of workers used by the searches, and can be used by
+ * several threads at the same time. With more than one worker, each search starts its own worker threads and joins
+ * them before returning.
+ */
+typedef struct diatony_solver diatony_solver;
+
+/**
+ * @return the version of the interface implemented by the library (see DIATONY_API_VERSION)
+ */
+int diatony_api_version(void);
+
+/**
+ * Creates a solver handle
+ * @param n_workers the number of worker threads searching each problem in parallel, 0 for one per hardware thread
+ * @param cache_size the maximum number of solutions kept for the problems solved recently, 0 to disable the cache
+ * @return the handle, or NULL if it could not be created
+ */
+diatony_solver* diatony_solver_create(unsigned int n_workers, unsigned int cache_size);
+
+/**
+ * Destroys a solver handle. No search may be running on it.
+ * @param solver the handle, can be NULL
+ */
+void diatony_solver_destroy(diatony_solver* solver);
+
+/**
+ * Cancels the searches running on a solver handle. They stop within a millisecond and return DIATONY_CANCELLED. The
+ * searches started afterwards are not affected.
+ * @param solver the handle, can be NULL
+ */
+void diatony_solver_cancel(diatony_solver* solver);
+
+/**
+ * Solves a progression in a single tonality
+ * @param solver the handle
+ * @param tonic the tonic of the tonality
+ * @param mode the mode of the tonality (major or minor)
+ * @param n_chords the number of chords
+ * @param degrees the degree of each chord (n_chords values)
+ * @param qualities the quality of each chord (n_chords values)
+ * @param states the state of each chord (n_chords values)
+ * @param time_limit_ms the time limit of the search in milliseconds
+ * @param voicing receives the notes of the solution [bass0, tenor0, alto0, soprano0, bass1, ...] (4 * n_chords values)
+ * @param costs receives the costs of the solution in lexicographical order
+ * @param costs_capacity the number of values that fit in costs
+ * @param n_costs receives the number of costs of the solution, or the required capacity
+ * @return the status of the search (see diatony_status)
+ */
+int diatony_solve(diatony_solver* solver, int tonic, int mode, int n_chords, const int* degrees, const int* qualities,
+                  const int* states, double time_limit_ms, int* voicing, int* costs, int costs_capacity, int* n_costs);
+
+/**
+ * Solves a piece made of several sections in different tonalities. The chords of the sections are concatenated in
+ * the degrees, qualities and states arrays. The sections follow each other, except after a pivot chord modulation,
+ * where the first chord of the next section is the last chord of the previous one (it appears in both sections).
+ * @param solver the handle
+ * @param n_sections the number of sections
+ * @param tonics the tonic of each section (n_sections values)
+ * @param modes the mode of each section (n_sections values)
+ * @param sizes the number of chords of each section (n_sections values)
+ * @param modulation_types the type of each modulation (n_sections - 1 values)
+ * @param modulation_starts the position of the first chord of each modulation in the piece (n_sections - 1 values)
+ * @param modulation_ends the position of the last chord of each modulation in the piece (n_sections - 1 values)
+ * @param degrees the degree of each chord of each section (sum of sizes values)
+ * @param qualities the quality of each chord of each section (sum of sizes values)
+ * @param states the state of each chord of each section (sum of sizes values)
+ * @param time_limit_ms the time limit of the search in milliseconds
+ * @param voicing receives the notes of the solution [bass0, tenor0, alto0, soprano0, bass1, ...]
+ * @param voicing_capacity the number of values that fit in voicing (4 values per chord of the piece)
+ * @param costs receives the costs of the solution in lexicographical order
+ * @param costs_capacity the number of values that fit in costs
+ * @param n_costs receives the number of costs of the solution, or the required capacity
+ * @return the status of the search (see diatony_status)
+ */
+int diatony_solve_sections(diatony_solver* solver, int n_sections, const int* tonics, const int* modes,
+                           const int* sizes, const int* modulation_types, const int* modulation_starts,
+                           const int* modulation_ends, const int* degrees, const int* qualities, const int* states,
+                           double time_limit_ms, int* voicing, int voicing_capacity, int* costs, int costs_capacity,
+                           int* n_costs);
+
+/**
+ * Copies the message of the last error that occurred on the calling thread
+ * @param buffer receives the message, truncated and null-terminated, can be NULL
+ * @param capacity the number of characters that fit in buffer
+ * @return the length of the message, without the terminating null character
+ */
+size_t diatony_last_error(char* buffer, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DIATONYCAPI_H */
@@ -0,0 +1,149 @@
+#ifndef DIATONYSERVER_HPP
+#define DIATONYSERVER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+
+#include "SolutionCache.hpp"
+#include "../aux/Utilities.hpp"
+
+/**
+ * The frames exchanged with a DiatonyServer. Every frame is a 32-bit length followed by that many bytes, and all the
+ * integers are 32-bit little-endian.
+ * SOLVE_REQUEST:  type, request id, time limit (ms, negative for 60 s), number of chords, number of sections,
+ *                 for each section: tonic, mode, start, size, then size times (degree, quality, state),
+ *                 for each modulation (number of sections - 1): type, start, end
+ * CANCEL_REQUEST: type, request id
+ * SOLVE_RESPONSE: type, request id, status, number of costs, costs, number of notes, notes [bass0, tenor0, ...],
+ *                 then the error message (the remaining bytes of the frame) if the status is RESPONSE_INVALID
+ */
+enum server_frame_types {
+    SOLVE_REQUEST,      //0
+    CANCEL_REQUEST,     //1
+    SOLVE_RESPONSE      //2
+};
+
+/** The status of a response of a DiatonyServer */
+enum server_response_status {
+    RESPONSE_SOLVED,        //0, the best solution found within the time limit
+    RESPONSE_NO_SOLUTION,   //1, no solution was found within the time limit
+    RESPONSE_INVALID,       //2, the request was malformed or its parameters were rejected (see check_parameters)
+    RESPONSE_CANCELLED,     //3, the request was cancelled. The solution is the best one found before, if any.
+    RESPONSE_EXPIRED        //4, the time limit was reached before a worker took the request
+};
+
+/// the maximum size of a frame in bytes, larger frames close the connection
+constexpr int MAX_SERVER_FRAME_SIZE = 1 << 20;
+
+/**
+ * A long-running solver process listening on a Unix domain socket. Several clients can be connected at the same
+ * time, and each of them can send several requests without waiting for the responses, which are sent as soon as they
+ * are ready (see server_frame_types for the format). The requests are solved by a pool of worker threads with
+ * solve_diatony, each under its own time limit, counted from its reception. A request can be cancelled by its client,
+ * and the requests of a client that disconnects are cancelled.
+ * The tonalities and voicing tables stay in memory between requests, and the solutions of the most recent problems
+ * are kept, so that a problem already solved with at least the same time limit is answered without searching.
+ */
+class DiatonyServer {
+protected:
+    struct Connection;
+    struct Request;
+
+    string                          socketPath;         // the path of the Unix domain socket
+    unsigned int                    nWorkers;           // the number of worker threads
+    std::atomic<int>                listenFd;           // the listening socket, -1 if the server is not running
+    std::atomic<int>                wakeFd;             // the write end of the pipe waking the accept loop, or -1
+    std::atomic<bool>               running;
+
+    std::mutex                      connectionsLock;
+    std::condition_variable         connectionsChanged;
+    std::set<std::shared_ptr<Connection>> connections;  // the open connections
+
+    std::mutex                      queueLock;
+    std::condition_variable         queueChanged;
+    std::deque<std::shared_ptr<Request>> queue;         // the requests waiting for a worker
+
+    std::mutex                      requestsLock;
+    std::map<std::pair<const Connection*, int>, std::shared_ptr<Request>> requests; // the pending requests
+
+    SolutionCache                   cache;              // the solutions of the recent problems, keyed by their encoding
+
+    /**
+     * Reads the frames of a connection until the client disconnects or the server shuts down
+     * @param connection the connection
+     */
+    void serve(const std::shared_ptr<Connection>& connection);
+
+    /**
+     * Takes requests from the queue and solves them until the server shuts down
+     */
+    void work();
+
+    /**
+     * Solves a request and sends its response
+     * @param request the request
+     */
+    void solve(Request& request);
+
+    /**
+     * Removes a request from the pending requests and sends its response, so that its client can reuse its id as
+     * soon as it receives the response
+     * @param request the request
+     * @param status the status of the response (see server_response_status)
+     * @param voicing the notes of the solution, empty if there is none
+     * @param costs the costs of the solution, empty if there is none
+     * @param error the error message if the status is RESPONSE_INVALID
+     */
+    void finish(const Request& request, int status, const vector<int>& voicing = {}, const vector<int>& costs = {},
+                const string& error = "");
+
+    /**
+     * Answers the requests left in the queue as cancelled
+     */
+    void cancel_queued();
+
+    /**
+     * Sends the response to a request. Nothing is sent if the client disconnected.
+     * @param request the request
+     * @param status the status of the response (see server_response_status)
+     * @param voicing the notes of the solution, empty if there is none
+     * @param costs the costs of the solution, empty if there is none
+     * @param error the error message if the status is RESPONSE_INVALID
+     */
+    static void respond(const Request& request, int status, const vector<int>& voicing = {},
+                        const vector<int>& costs = {}, const string& error = "");
+
+public:
+    /**
+     * Constructor
+     * @param socketPath the path of the Unix domain socket. An existing file at this path is replaced.
+     * @param nWorkers the number of worker threads. If it is 0, one worker per hardware thread is used.
+     * @param cacheSize the maximum number of solutions kept
+     */
+    explicit DiatonyServer(string socketPath, unsigned int nWorkers = 0, size_t cacheSize = 256);
+
+    DiatonyServer(const DiatonyServer&) = delete;
+
+    DiatonyServer& operator=(const DiatonyServer&) = delete;
+
+    ~DiatonyServer();
+
+    /**
+     * Listens on the socket and serves the clients until shutdown is called
+     * @throws std::runtime_error if the socket cannot be created
+     */
+    void run();
+
+    /**
+     * Stops the server: no new client is accepted, the pending requests are cancelled and run returns once the
+     * connections are closed. This function is thread-safe, but it must not be called from a signal handler.
+     */
+    void shutdown();
+};
+
+#endif //DIATONYSERVER_HPP
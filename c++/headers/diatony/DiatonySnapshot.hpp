@@ -0,0 +1,57 @@
+#ifndef DIATONYSNAPSHOT_HPP
+#define DIATONYSNAPSHOT_HPP
+
+#include <mutex>
+
+#include "FourVoiceTexture.hpp"
+#include "../aux/Utilities.hpp"
+
+/**
+ * This class keeps the root space of a Four voice texture problem after its construction and root propagation, so
+ * that the same piece can be solved several times (other time budgets, other solutions, ...) without building the
+ * model and propagating the root again: each search starts from a clone of the snapshot.
+ * Cloning a space updates the space being cloned, so the clones are serialized by a mutex. A snapshot can thus be
+ * shared by several threads. The branching (and the seed of random heuristics) is the one given to the constructor.
+ * The parameters must outlive the snapshot. It can neither be copied nor moved.
+ */
+class DiatonySnapshot {
+protected:
+    FourVoiceTextureParameters*     params;             // the parameters of the problem (not owned)
+    FourVoiceTexture*               root;               // the propagated root space, nullptr if it failed
+    mutable std::mutex              lock;               // serializes the clones of the root space
+
+public:
+    /**
+     * Constructor. Checks the parameters, then builds the model and propagates it at the root.
+     * @param params the parameters of the problem
+     * @param variableSelection the variable selection heuristic used by the branching (see variable_selection_heuristics)
+     * @param valueSelection the value selection heuristic used by the branching (see value_selection_heuristics)
+     * @param seed the seed used by random heuristics
+     * @throws std::invalid_argument if the parameters are invalid (see check_parameters)
+     */
+    explicit DiatonySnapshot(FourVoiceTextureParameters* params, int variableSelection = RIGHT_TO_LEFT,
+                             int valueSelection = VAL_RND, unsigned int seed = 1U);
+
+    DiatonySnapshot(const DiatonySnapshot&) = delete;
+
+    DiatonySnapshot& operator=(const DiatonySnapshot&) = delete;
+
+    ~DiatonySnapshot();
+
+    /**                     getters                     **/
+    FourVoiceTextureParameters* get_parameters() const { return params; }
+
+    /**
+     * Returns whether root propagation proved that the problem has no solution
+     * @return true if the problem has no solution
+     */
+    bool failed() const { return root == nullptr; }
+
+    /**
+     * Returns a new copy of the propagated root space. This function is thread-safe.
+     * @return a clone of the root space owned by the caller, or nullptr if the problem has no solution
+     */
+    FourVoiceTexture* clone() const;
+};
+
+#endif //DIATONYSNAPSHOT_HPP
@@ -0,0 +1,63 @@
+#ifndef DIATONYSOLUTION_HPP
+#define DIATONYSOLUTION_HPP
+
+#include "FourVoiceTexture.hpp"
+#include "../aux/Utilities.hpp"
+
+/**
+ * This class is a compact record of a solution to the Four voice texture problem: the voicing of the piece, its cost
+ * vector and the statistics of the search when it was found. Unlike a solution Space, it does not hold any variable
+ * or propagator, so the best solution of a long search can be kept without cloning spaces. It can be moved but not
+ * copied. A default constructed record holds no solution.
+ */
+class DiatonySolution {
+protected:
+    vector<int>             voicing;        // the notes of each voice for each chord [bass0, tenor0, alto0, soprano0, bass1, ...]
+    vector<int>             costs;          // the costs in lexicographical order
+    Search::Statistics      statistics;     // the statistics of the search when the solution was found
+
+public:
+    /**
+     * Constructor for an empty record (no solution)
+     */
+    DiatonySolution() = default;
+
+    /**
+     * Constructor. Extracts the values of a solution.
+     * @param sol a solution of the Four voice texture problem. It can be deleted afterwards.
+     * @param statistics the statistics of the search when the solution was found
+     */
+    DiatonySolution(const FourVoiceTexture& sol, const Search::Statistics& statistics);
+
+    /**
+     * Constructor
+     * @param voicing the notes of each voice for each chord [bass0, tenor0, alto0, soprano0, bass1, ...]
+     * @param costs the costs in lexicographical order
+     * @param statistics the statistics of the search when the solution was found
+     */
+    DiatonySolution(vector<int> voicing, vector<int> costs, const Search::Statistics& statistics = Search::Statistics());
+
+    DiatonySolution(DiatonySolution&&) = default;
+    DiatonySolution& operator=(DiatonySolution&&) = default;
+    DiatonySolution(const DiatonySolution&) = delete;
+    DiatonySolution& operator=(const DiatonySolution&) = delete;
+
+    /**                     getters                     **/
+    bool found() const { return !voicing.empty(); }
+
+    const vector<int>& get_voicing() const { return voicing; }
+
+    const vector<int>& get_costs() const { return costs; }
+
+    const Search::Statistics& get_statistics() const { return statistics; }
+
+    int get_number_of_chords() const { return static_cast<int>(voicing.size()) / 4; }
+
+    /**
+     * to_string method for the DiatonySolution object.
+     * @return a string representation of the solution
+     */
+    string to_string() const;
+};
+
+#endif //DIATONYSOLUTION_HPP
@@ -5,8 +5,12 @@
 #ifndef FOURVOICETEXTURE_HPP
 #define FOURVOICETEXTURE_HPP
 
+#include <memory>
+
 #include "TonalProgression.hpp"
 #include "FourVoiceTextureParameters.hpp"
+#include "SharedCostBound.hpp"
+#include "ChordBrancher.hpp"
 #include "../aux/Utilities.hpp"
 
 /**
@@ -18,26 +22,16 @@ class FourVoiceTexture : public IntLexMinimizeSpace { // todo add IntLexMinimize
 protected:
     int                             nVoices = 4;
     FourVoiceTextureParameters*     params;                         // The parameters that define the problem
-    vector<TonalProgression*>       tonalProgressions;              // The tonal progressions subproblems
+    /// The tonal progressions subproblems. They hold no variables, so they are shared by all the clones of the space
+    vector<std::shared_ptr<TonalProgression>> tonalProgressions;
 
     IntVarArray                     fullVoicing;                    // The voicing of the chords for the whole piece
+    IntVarArray                     pitchClasses;                   // The pitch class of each note of fullVoicing
 
-    /// Melodic intervals
-    IntVarArray                     bassMelodicIntervals;
-    IntVarArray                     tenorMelodicIntervals;
-    IntVarArray                     altoMelodicIntervals;
-    IntVarArray                     sopranoMelodicIntervals;
+    /// Melodic intervals for all voices [bass0, tenor0, alto0, soprano0, bass1, ...]. The intervals of a single voice
+    /// are allMelodicIntervals.slice(voice, nVoices). Harmonic intervals are not stored (see restrain_voices_spacing).
     IntVarArray                     allMelodicIntervals;
 
-    /// Harmonic intervals (always positive)
-    IntVarArray                     bassTenorHarmonicIntervals;
-    IntVarArray                     bassAltoHarmonicIntervals;
-    IntVarArray                     bassSopranoHarmonicIntervals;
-    IntVarArray                     tenorAltoHarmonicIntervals;
-    IntVarArray                     tenorSopranoHarmonicIntervals;
-    IntVarArray                     altoSopranoHarmonicIntervals;
-
-
     /**------------------------------------------------- costs --------------------------------------------------**/
     /// Variables for each type of interval
     IntVar                          nOfUnisons;
@@ -59,12 +53,39 @@ protected:
 
     IntVarArgs                      costVector;                                 // the costs in lexicographical order for minimization
 
+    /// search-related attributes
+    SharedCostBound*                sharedBound = nullptr;                      // the best cost shared with other engines (not owned)
+    bool                            lns = false;                                // whether restarts relax a neighbourhood of the incumbent
+    int                             lnsWindowSize = 0;                          // the maximum number of chords relaxed at each restart
+    unsigned int                    lnsSeed = 1U;                               // the seed used to pick the neighbourhoods
+
+    /// the rules posted by the constructor (see ConstraintRegistry). Only the space built by the constructor has it,
+    /// it is not copied to the clones used by the search
+    string                          constructionReport;
+
+    /**
+     * Posts the branching on the voicing of the piece
+     * @param variableSelection the variable selection heuristic (see variable_selection_heuristics)
+     * @param valueSelection the value selection heuristic (see value_selection_heuristics), ignored by CHORD_COST_GUIDED
+     * @param seed the seed used for random heuristics
+     */
+    void post_branching(int variableSelection, int valueSelection, unsigned int seed);
+
+    /**
+     * Constrains the cost vector to be strictly lower than the best cost found by the engines sharing the bound, if any
+     */
+    void post_shared_bound();
+
 public:
     /**
      * Constructor for FourVoiceTexture objects.
      * @param params An object containing the parameters for the whole piece.
+     * @param variableSelection the variable selection heuristic used by the branching (see variable_selection_heuristics)
+     * @param valueSelection the value selection heuristic used by the branching (see value_selection_heuristics)
+     * @param seed the seed used by random heuristics
      */
-    explicit FourVoiceTexture(FourVoiceTextureParameters* params);
+    explicit FourVoiceTexture(FourVoiceTextureParameters* params, int variableSelection = RIGHT_TO_LEFT,
+                              int valueSelection = VAL_RND, unsigned int seed = 1U);
 
     /**
      * Copy constructor for FourVoiceTexture objects.
@@ -72,17 +93,74 @@ public:
      */
     FourVoiceTexture(FourVoiceTexture& s);
 
-    /**
-     * Returns the values taken by the variables vars in a solution as a pointer to an integer array
-     * @return an array of integers representing the values of the variables in a solution
-     */
-    int* return_solution() const;
-
     /**                     getters                     **/
     int getNVoices() const { return nVoices; }
 
     FourVoiceTextureParameters* getParameters() const { return params; }
 
+    /**
+     * Returns the number of rules, duplicates rejected and propagators of each rule family posted by the constructor.
+     * It is empty for the clones of the space.
+     * @return a string with a line per rule family
+     */
+    string get_construction_report() const { return constructionReport; }
+
+    /**
+     * Returns the values of the cost variables in a solution
+     * @return a vector containing the value of each cost in lexicographical order
+     */
+    vector<int> get_cost_values() const;
+
+    /**
+     * Returns the values of the voicing variables in a solution
+     * @return a vector containing the notes of each voice for each chord [bass0, tenor0, alto0, soprano0, bass1, ...]
+     */
+    vector<int> get_voicing_values() const;
+
+    /**
+     * Shares the best cost found with other engines solving the same problem. Every solution found by an engine on
+     * this space (or its copies) must then be strictly better than the best cost published in the bound.
+     * @param bound the shared bound. It is not owned by the space and must outlive the search.
+     */
+    void set_shared_bound(SharedCostBound* bound) { sharedBound = bound; }
+
+    /**
+     * Fixes the voicing of the piece to the given values, e.g. to check a voicing found by another solver. The
+     * constraints are only posted, propagation happens on the next call to status().
+     * @param voicing the notes of each voice for each chord [bass0, tenor0, alto0, soprano0, bass1, ...]
+     */
+    void constrain_voicing(const vector<int>& voicing);
+
+    /**
+     * Constrains the cost vector to be lexicographically strictly lower than a bound, e.g. the cost of a solution found
+     * by a heuristic
+     * @param bound the costs in lexicographical order
+     */
+    void constrain_costs(const vector<int>& bound);
+
+    /**
+     * Forbids a set of chords to take the given voicings all at once. At least one note of one of the chords must
+     * differ from the given voicing.
+     * @param chords the positions of the chords in the piece
+     * @param voicing the forbidden notes of each chord [bass, tenor, alto, soprano of chords[0], bass of chords[1], ...]
+     */
+    void forbid_chords_voicing(const vector<int>& chords, const vector<int>& voicing);
+
+    /**
+     * Restricts the voicing of a section to one of the given candidates
+     * @param section the index of the section
+     * @param candidates the allowed voicings of the section, each one having 4 notes per chord of the section
+     */
+    void restrict_section_voicing(int section, const vector<vector<int>>& candidates);
+
+    /**
+     * Turns restart-based search on this space into a Large Neighbourhood Search. After the first solution, each
+     * restart keeps the incumbent voicing and only relaxes a neighbourhood of it (see lns_neighbourhoods).
+     * @param windowSize the maximum number of consecutive chords relaxed at each restart
+     * @param seed the seed used to pick the neighbourhoods
+     */
+    void set_lns(int windowSize, unsigned int seed = 1U);
+
     /**
      * General space copy method
      * @return a new FourVoiceTexture object that is a copy of this one, as a Space pointer
@@ -95,6 +173,29 @@ public:
      */
     IntVarArgs cost() const override;
 
+    /**
+     * Constrain function for branch and bound search. Posts the cost of the best solution found by this engine, and
+     * the shared bound if there is a better one.
+     * @param best the best solution found so far by the engine
+     */
+    void constrain(const Space& best) override;
+
+    /**
+     * Master configuration for restart-based search. Also posts the shared bound, so that each restart starts from
+     * the best cost found by all the engines.
+     * @param mi the meta information about the restart
+     * @return true if the search must restart, false otherwise
+     */
+    bool master(const MetaInfo& mi) override;
+
+    /**
+     * Slave configuration for restart-based search. In LNS mode, fixes every voicing variable outside of a randomly
+     * chosen neighbourhood to its value in the last solution found.
+     * @param mi the meta information about the restart
+     * @return true if the search on the slave is complete (no neighbourhood was relaxed), false otherwise
+     */
+    bool slave(const MetaInfo& mi) override;
+
     /**
      * to_string method for the FourVoiceTexture object.
      * @return a string representation of the FourVoiceTexture object
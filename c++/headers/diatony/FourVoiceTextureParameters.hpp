@@ -43,7 +43,7 @@ public:
 
     int get_sectionEnd(const int section) const { return sectionParameters[section]->get_end(); }
 
-    Tonality* get_sectionTonality(const int section) const { return sectionParameters[section]->get_tonality(); }
+    const Tonality* get_sectionTonality(const int section) const { return sectionParameters[section]->get_tonality(); }
 
     vector<TonalProgressionParameters*> get_sectionParameters() const { return sectionParameters; }
 
@@ -51,6 +51,8 @@ public:
 
     ModulationParameters* get_modulationParameters(const int modulation) const { return modulationParameters[modulation]; }
 
+    int get_numberOfModulations() const { return static_cast<int>(modulationParameters.size()); }
+
     /**
      * toString method
      * Prints the total number of chords of the piece, the number of sections, the section starts and ends, the tonalities of
@@ -13,7 +13,8 @@
  * This file contains all the general constraints. It currently contains:                                              *
  *     - restrain_voices_domains: sets the domains of the different voices to their range and gives them their order   *
  *     - link_melodic_arrays: links the melodic intervals arrays to the fullChordsVoicing array for each voice         *
- *     - link_harmonic_arrays: links the harmonic intervals arrays to the fullChordsVoicing array for each voice       *
+ *     - restrain_voices_spacing: restrains the space between adjacent voices                                          *
+ *     - link_pitch_class_arrays: links the pitch class array to the fullChordsVoicing array                           *
  *                                                                                                                     *
  ***********************************************************************************************************************/
 
@@ -30,37 +31,36 @@ void restrain_voices_domains(const Home &home, int nVoices, int n, const vector<
     const vector<int> &upperBounds, IntVarArray &fullChordsVoicing);
 
 /**
- * Link the melodic intervals arrays to the fullChordsVoicing array
+ * Link the melodic intervals array to the fullChordsVoicing array. The melodic intervals of a single voice are the
+ * slice allMelodicIntervals.slice(voice, nVoices), no other array is needed.
  * @param home The instance of the problem
  * @param nVoices the number of voices
  * @param params the parameters of the progression
  * @param fullChordsVoicing the array containing all the chords in the form [bass0, alto0, tenor0, soprano0, bass1, ...]
- * @param bassMelodicIntervals the melodic intervals of the bass
- * @param tenorMelodicIntervals the melodic intervals of the tenor
- * @param altoMelodicIntervals the melodic intervals of the alto
- * @param sopranoMelodicIntervals the melodic intervals of the soprano
- * @param allMelodicIntervals the array containing all the melodic intervals in the form
+ * @param allMelodicIntervals the array containing all the melodic intervals in the form [bass0, tenor0, alto0,
+ * soprano0, bass1, ...], where the interval i is between chord i and chord i+1
  */
 void link_melodic_arrays(const Home &home, int nVoices, const FourVoiceTextureParameters* params,
-                         IntVarArray &fullChordsVoicing, IntVarArray &bassMelodicIntervals,
-                         IntVarArray &altoMelodicIntervals, IntVarArray &tenorMelodicIntervals,
-                         IntVarArray &sopranoMelodicIntervals, IntVarArray &allMelodicIntervals);
+                         IntVarArray &fullChordsVoicing, IntVarArray &allMelodicIntervals);
 
 /**
- * Link the harmonic intervals arrays to the fullChordsVoicing array for each voice
+ * Restrains the space between adjacent voices: at most an octave and a fifth between the bass and the tenor, and at most
+ * an octave between the tenor and the alto and between the alto and the soprano. The harmonic intervals are not stored
+ * in variables, the constraints are posted directly on the notes.
  * @param home the instance of the problem
  * @param nVoices the number of voices in the chords
  * @param size the number of chords
  * @param fullChordsVoicing the array containing all the chords in the form [bass0, alto0, tenor0, soprano0, bass1, ...]
- * @param bassTenorHarmonicIntervals the harmonic intervals between bass and tenor
- * @param bassAltoHarmonicIntervals the harmonic intervals between bass and alto
- * @param bassSopranoHarmonicIntervals the harmonic intervals between bass and soprano
- * @param tenorAltoHarmonicIntervals the harmonic intervals between tenor and alto
- * @param tenorSopranoHarmonicIntervals the harmonic intervals between tenor and soprano
- * @param altoSopranoHarmonicIntervals the harmonic intervals between alto and soprano
  */
-void link_harmonic_arrays(const Home &home, int nVoices, int size, IntVarArray fullChordsVoicing,
-                          IntVarArray bassTenorHarmonicIntervals,    IntVarArray bassAltoHarmonicIntervals,
-                          IntVarArray bassSopranoHarmonicIntervals,  IntVarArray tenorAltoHarmonicIntervals,
-                          IntVarArray tenorSopranoHarmonicIntervals, IntVarArray altoSopranoHarmonicIntervals);
+void restrain_voices_spacing(const Home &home, int nVoices, int size, const IntVarArray &fullChordsVoicing);
+
+/**
+ * Link the pitch class array to the fullChordsVoicing array. The rules that only depend on the pitch class of a note
+ * read it from this array instead of posting their own modulo.
+ * @param home the instance of the problem
+ * @param fullChordsVoicing the array containing all the chords in the form [bass0, alto0, tenor0, soprano0, bass1, ...]
+ * @param pitchClasses the pitch class of each note of fullChordsVoicing, in [0,11]
+ */
+void link_pitch_class_arrays(const Home &home, const IntVarArray &fullChordsVoicing, IntVarArray &pitchClasses);
+
 #endif
\ No newline at end of file
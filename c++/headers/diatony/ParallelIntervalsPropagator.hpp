@@ -0,0 +1,20 @@
+#ifndef PARALLELINTERVALSPROPAGATOR_HPP
+#define PARALLELINTERVALSPROPAGATOR_HPP
+
+#include "../aux/Utilities.hpp"
+
+/**
+ * Forbids parallel intervals between every pair of voices of two consecutive chords, using a single dedicated
+ * propagator. Two voices move in parallel if they form the same forbidden interval (regardless of the octave) in both
+ * chords, unless neither voice moves. The propagator only wakes up when a note is fixed, and then removes from the
+ * other voices the notes that would create a parallel interval.
+ * @param home the instance of the problem
+ * @param currentChord the notes of the first chord [bass, tenor, alto, soprano]
+ * @param nextChord the notes of the second chord [bass, tenor, alto, soprano]
+ * @param intervals the list of intervals to forbid. They are taken modulo an octave, so that octaves and unisons are
+ * the same interval.
+ */
+void no_parallel_intervals(Home home, const IntVarArgs& currentChord, const IntVarArgs& nextChord,
+                           const vector<int>& intervals);
+
+#endif //PARALLELINTERVALSPROPAGATOR_HPP
@@ -0,0 +1,30 @@
+#ifndef PARAMETERSVALIDATOR_HPP
+#define PARAMETERSVALIDATOR_HPP
+
+#include "FourVoiceTextureParameters.hpp"
+#include "../aux/Utilities.hpp"
+
+/**
+ * Checks the parameters of a four voice texture problem without building the model. It detects:
+ * - the structural errors: the number of chords, sections and modulations, the positions of the sections (they must
+ *   cover the piece in order, and only overlap on the pivot chord of a pivot chord modulation) and of the modulations,
+ *   the lengths of the chord vectors and the degrees, qualities and states of the chords;
+ * - the pivot chords that are not the same chord in both tonalities;
+ * - the transitions that are unsatisfiable whatever the voicing: a note that every voicing of a chord contains (its
+ *   bass, its third and its seventh) and that must move to a note absent from the next chord (tritone resolution,
+ *   preparation of species sevenths, chromatic modulations).
+ * The checks only rely on the pitch classes of the chords, so they run in time linear in the number of chords. A
+ * problem passing them can still have no solution.
+ * @param params the parameters of the problem
+ * @return a message for each problem found, empty if the parameters are valid
+ */
+vector<string> validate_parameters(const FourVoiceTextureParameters* params);
+
+/**
+ * Checks the parameters of a four voice texture problem (see validate_parameters)
+ * @param params the parameters of the problem
+ * @throws std::invalid_argument listing the problems found, if any
+ */
+void check_parameters(const FourVoiceTextureParameters* params);
+
+#endif //PARAMETERSVALIDATOR_HPP
@@ -0,0 +1,152 @@
+#ifndef RULEPOSTING_HPP
+#define RULEPOSTING_HPP
+
+#include <map>
+#include <tuple>
+#include <functional>
+
+#include "../aux/Utilities.hpp"
+
+/**
+ * Posting layer for the "if ... then ..." rules of the model. Instead of reifying both sides of a rule and linking them
+ * with a Boolean implication (3 propagators and 2 Boolean variables per rule), rules are posted with half reification:
+ *  - the premise of a rule is a literal b with [x rel c] -> b (RM_PMI),
+ *  - the consequence is posted directly as x rel c under b -> [x rel c] (RM_IMP).
+ * This keeps the same propagation in both directions (the contrapositive still removes the premise value when the
+ * consequence cannot hold) with a single reified propagator per side.
+ * Literals are shared: asking twice for the same literal (same variable, relation and constant) returns the same
+ * Boolean variable, and the missing direction is posted when a half reified literal is later needed as a full
+ * equivalence. Literals are identified by the variable implementations, so an object of this class must only be used
+ * while posting the constraints of a space. A single object is shared by all the rules of a space through its
+ * ConstraintRegistry (see ConstraintRegistry::get_literals), so that it lives exactly as long as the construction.
+ * Defining DIATONY_FULL_REIFICATION at compile time makes every literal fully reified (RM_EQV), which gives the
+ * propagation profile of the previous formulation for benchmarks (see efficiency_measurment/PropagationsPerNode.cpp).
+ */
+class RuleLiterals {
+protected:
+    /// (variable, relation or LITERAL_DOMAIN, other variable or nullptr, first constant, second constant)
+    typedef std::tuple<const void*, int, const void*, int, int> LiteralKey;
+
+    /// a literal and the directions of its reification that are already posted
+    struct Literal {
+        BoolVar     var;
+        ReifyMode   mode;
+    };
+
+    Home                            home;
+    std::map<LiteralKey, Literal>   literals;
+
+    /**
+     * Returns the literal with the given key, creating it if needed. If the literal exists but only one direction of
+     * the requested mode is posted, the missing direction is posted with the post function.
+     * @param key the key of the literal
+     * @param mode the reification mode needed by the caller
+     * @param post posts the reified constraint of the literal with the given Reify object
+     * @return the Boolean variable of the literal
+     */
+    BoolVar literal(const LiteralKey& key, ReifyMode mode, const std::function<void(const Reify&)>& post);
+
+public:
+    /**
+     * Constructor
+     * @param home the space in which the rules are posted
+     */
+    explicit RuleLiterals(Home home);
+
+    /**
+     * Returns a literal that is true if x rel c holds ([x rel c] -> b). It can only be used as a premise.
+     * @param x the variable
+     * @param irt the relation
+     * @param c the constant
+     * @return the Boolean variable of the literal
+     */
+    BoolVar premise(const IntVar& x, IntRelType irt, int c);
+
+    /**
+     * Returns a literal that is true if x rel y holds ([x rel y] -> b). It can only be used as a premise.
+     * @param x the first variable
+     * @param irt the relation
+     * @param y the second variable
+     * @return the Boolean variable of the literal
+     */
+    BoolVar premise(const IntVar& x, IntRelType irt, const IntVar& y);
+
+    /**
+     * Returns a literal that forces x rel c when it is true (b -> [x rel c]). It can only be used as a consequence.
+     * @param x the variable
+     * @param irt the relation
+     * @param c the constant
+     * @return the Boolean variable of the literal
+     */
+    BoolVar consequence(const IntVar& x, IntRelType irt, int c);
+
+    /**
+     * Returns a literal that is equivalent to x rel c (b <-> [x rel c])
+     * @param x the variable
+     * @param irt the relation
+     * @param c the constant
+     * @return the Boolean variable of the literal
+     */
+    BoolVar condition(const IntVar& x, IntRelType irt, int c);
+
+    /**
+     * Returns a literal that is equivalent to min <= x <= max (b <-> [x in min..max])
+     * @param x the variable
+     * @param min the lower bound of the range
+     * @param max the upper bound of the range
+     * @return the Boolean variable of the literal
+     */
+    BoolVar condition(const IntVar& x, int min, int max);
+
+    /**
+     * Posts b -> x rel c with half reification
+     * @param b the premise
+     * @param x the variable
+     * @param irt the relation
+     * @param c the constant
+     */
+    void implies(const BoolVar& b, const IntVar& x, IntRelType irt, int c);
+
+    /**
+     * Posts b -> min <= x <= max with a single half reified domain constraint
+     * @param b the premise
+     * @param x the variable
+     * @param min the lower bound of the range
+     * @param max the upper bound of the range
+     */
+    void implies(const BoolVar& b, const IntVar& x, int min, int max);
+
+    /**
+     * Posts b -> x in values with a single half reified domain constraint
+     * @param b the premise
+     * @param x the variable
+     * @param values the values allowed for x when b is true
+     */
+    void implies(const BoolVar& b, const IntVar& x, const IntSet& values);
+
+    /**
+     * Posts (premises[0] && premises[1] && ...) -> x rel c as a clause on the premises and a consequence literal
+     * @param premises the premises of the rule
+     * @param x the variable
+     * @param irt the relation
+     * @param c the constant
+     */
+    void implies_all(const BoolVarArgs& premises, const IntVar& x, IntRelType irt, int c);
+
+    /**
+     * Posts b <-> x rel c. b is used directly as the reification variable, so no auxiliary literal is created.
+     * @param b the condition
+     * @param x the variable
+     * @param irt the relation
+     * @param c the constant
+     */
+    void equivalent(const BoolVar& b, const IntVar& x, IntRelType irt, int c);
+
+    /**
+     * Returns the number of distinct literals created so far
+     * @return the number of literals
+     */
+    int size() const { return static_cast<int>(literals.size()); }
+};
+
+#endif //RULEPOSTING_HPP
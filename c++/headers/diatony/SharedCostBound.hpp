@@ -0,0 +1,49 @@
+#ifndef SHAREDCOSTBOUND_HPP
+#define SHAREDCOSTBOUND_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "../aux/Utilities.hpp"
+
+/**
+ * This class holds the best lexicographic cost vector found so far by a group of search engines working on the same
+ * problem (e.g. the workers of a portfolio). It is thread safe: every worker publishes the cost of its solutions and
+ * reads the best known cost to constrain its own search.
+ */
+class SharedCostBound {
+protected:
+    mutable std::mutex          lock;                   // protects the cost vector
+    vector<int>                 bestCosts;              // the best cost vector found so far (empty if there is none)
+    std::atomic<bool>           done;                   // true once a worker proved optimality or the search was aborted
+
+public:
+    SharedCostBound() : done(false) {}
+
+    /**
+     * Publishes the cost vector of a new solution.
+     * @param costs the cost vector of a solution, in lexicographical order
+     * @return true if the cost vector is strictly better than the best one known so far, false otherwise
+     */
+    bool update(const vector<int>& costs);
+
+    /**
+     * Gets the best cost vector found so far.
+     * @param costs the vector in which the best cost vector is written
+     * @return true if a solution has been published, false otherwise (costs is then left untouched)
+     */
+    bool get(vector<int>& costs) const;
+
+    /**
+     * Signals every worker sharing this bound that the search is over.
+     */
+    void finish() { done.store(true); }
+
+    /**
+     * @return true if the search is over for every worker sharing this bound
+     */
+    bool is_done() const { return done.load(); }
+};
+
+#endif //SHAREDCOSTBOUND_HPP
@@ -0,0 +1,64 @@
+#ifndef SOLUTIONCACHE_HPP
+#define SOLUTIONCACHE_HPP
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "../aux/Utilities.hpp"
+
+/**
+ * This class keeps the solutions of the most recently solved problems. A problem is identified by an opaque key (e.g.
+ * its encoding in a request), and its solution is returned only to searches that would not have been given more time
+ * than the search that found it. When the cache is full, the least recently used solution is forgotten. This class is
+ * thread-safe.
+ */
+class SolutionCache {
+protected:
+    /** A solution of a problem */
+    struct Entry {
+        string          problem;            // the key of the problem
+        vector<int>     voicing;            // the notes of each chord [bass0, tenor0, alto0, soprano0, bass1, ...]
+        vector<int>     costs;              // the costs in lexicographical order
+        double          timeLimit;          // the time limit under which the solution was found
+    };
+
+    size_t                                                  capacity;   // the maximum number of solutions kept
+    std::mutex                                              lock;
+    std::list<Entry>                                        entries;    // from the most to the least recently used
+    std::unordered_map<string, std::list<Entry>::iterator>  index;      // the entry of each problem
+
+public:
+    /**
+     * Constructor
+     * @param capacity the maximum number of solutions kept. If it is 0, no solution is kept.
+     */
+    explicit SolutionCache(size_t capacity = 256) : capacity(capacity) {}
+
+    /**
+     * Looks for the solution of a problem found with at least a given time limit
+     * @param problem the key of the problem
+     * @param timeLimit the time limit of the search that needs the solution
+     * @param voicing filled with the notes of the solution if one is found
+     * @param costs filled with the costs of the solution if one is found
+     * @return true if a solution was found
+     */
+    bool find(const string& problem, double timeLimit, vector<int>& voicing, vector<int>& costs);
+
+    /**
+     * Keeps the solution of a problem, unless a solution found with a longer time limit is already kept. The least
+     * recently used solution is forgotten if the cache is full.
+     * @param problem the key of the problem
+     * @param timeLimit the time limit under which the solution was found
+     * @param voicing the notes of the solution
+     * @param costs the costs of the solution
+     */
+    void insert(const string& problem, double timeLimit, const vector<int>& voicing, const vector<int>& costs);
+
+    /**
+     * @return the number of solutions kept
+     */
+    size_t size();
+};
+
+#endif //SOLUTIONCACHE_HPP
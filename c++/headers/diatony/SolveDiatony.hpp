@@ -5,18 +5,130 @@
 #ifndef DIATONY_SOLVEPROBLEM_HPP
 #define DIATONY_SOLVEPROBLEM_HPP
 
+#include <functional>
+
+#include "CancellableStop.hpp"
 #include "FourVoiceTexture.hpp"
+#include "VoicingIndexModel.hpp"
+#include "DiatonySolution.hpp"
+#include "DiatonySnapshot.hpp"
 #include "../aux/Utilities.hpp"
 
+/**
+ * Observer of an anytime search. It is called with every improving solution, as soon as it is found, and with the time
+ * elapsed since the start of the search in milliseconds. The statistics of the solution are those of the engine that
+ * found it. The search goes on if the observer returns true, and stops at once if it returns false, in which case the
+ * solution it was given is the one returned by the search.
+ */
+typedef std::function<bool(const DiatonySolution& solution, double elapsed)> SolutionObserver;
+
+/// The time limit of the searches in milliseconds when no stop object is given in the options. Every search honours
+/// the stop object of its options, so a search can be cancelled from another thread with a CancellableStop.
+constexpr double DEFAULT_TIME_LIMIT = 60000;
+
 /**
  * Returns the best solution to the Four voice texture problem specified by the parameters. If the maximum search time
- * specified in the options is reached, the best solution found so far is returned.
+ * specified in the options is reached, the best solution found so far is returned. The search is warm started by a
+ * beam search whose solution bounds the branch and bound. It is returned without searching if the time left (given
+ * explicitly, or by a CancellableStop in the options) is under 10 ms, or if the stop object fired during the beam
+ * search.
+ * @param params the parameters of the problem, containing the tonalities, chord degrees, qualities and states for each chord in each progression
+ * @param opts the options for the search, containing the maximum search time, the restart strategy, etc. Without a
+ * cutoff, the default restart strategy is used.
+ * @param print whether to print the solutions found during the search
+ * @param timeLimit the time limit of the search in milliseconds, or a negative value if it is only known by the stop
+ * object of the options. If opts is nullptr, it replaces DEFAULT_TIME_LIMIT.
+ * @param observer called with every improving solution, including the warm start (see SolutionObserver)
+ * @return the best solution found, which is empty if no solution was found
+ * @throws std::invalid_argument if the parameters are invalid (see check_parameters)
+ */
+DiatonySolution solve_diatony(FourVoiceTextureParameters* params, const Options* opts = nullptr, bool print = false,
+                              double timeLimit = -1, const SolutionObserver& observer = nullptr);
+
+/**
+ * Returns the best solution to the Four voice texture problem of a snapshot, like solve_diatony on its parameters. The
+ * search starts from a clone of the snapshot, so the model is neither built nor propagated at the root again. This
+ * function can be called by several threads on the same snapshot.
+ * @param snapshot the propagated root space of the problem
+ * @param opts the options for the search, containing the maximum search time, the restart strategy, etc. Without a
+ * cutoff, the default restart strategy is used.
+ * @param print whether to print the solutions found during the search
+ * @param timeLimit the time limit of the search in milliseconds, or a negative value if it is only known by the stop
+ * object of the options. If opts is nullptr, it replaces DEFAULT_TIME_LIMIT.
+ * @param observer called with every improving solution, including the warm start (see SolutionObserver)
+ * @return the best solution found, which is empty if no solution was found
+ */
+DiatonySolution solve_diatony(const DiatonySnapshot& snapshot, const Options* opts = nullptr, bool print = false,
+                              double timeLimit = -1, const SolutionObserver& observer = nullptr);
+
+/**
+ * Returns the best solution to the Four voice texture problem specified by the parameters, using a portfolio of
+ * restart-based branch and bound engines running in parallel. Each worker uses a different branching, random seed and
+ * restart policy. The workers share the best cost vector found so far, and they all stop as soon as one of them proves
+ * optimality. If the stop object of the options stops the search, the best solution found so far is returned.
+ * @param params the parameters of the problem, containing the tonalities, chord degrees, qualities and states for each chord in each progression
+ * @param opts the options for the search. Only the stop object and the no-goods limit are used, as each worker has its
+ * own cutoff and runs on a single thread.
+ * @param print whether to print the solutions found during the search
+ * @param nWorkers the number of workers. If it is 0, one worker per hardware thread is used.
+ * @param observer called with every solution that improves on the best one of the portfolio (see SolutionObserver).
+ * The calls are serialized, but they are made from the threads of the workers.
+ * @return the best solution found, or nullptr if no solution was found
+ * @throws std::invalid_argument if the parameters are invalid (see check_parameters)
+ */
+const FourVoiceTexture* solve_diatony_portfolio(FourVoiceTextureParameters* params, const Options* opts = nullptr,
+                                                bool print = false, unsigned int nWorkers = 0,
+                                                const SolutionObserver& observer = nullptr);
+
+/**
+ * Returns a good solution to the Four voice texture problem specified by the parameters using Large Neighbourhood
+ * Search. After a first solution is found, each restart keeps the best voicing found so far and relaxes either a window
+ * of chords, a single voice or the boundary between two sections. LNS never proves optimality, so the search runs until
+ * the stop object of the options stops it, and the best solution found is returned. This is meant for long pieces,
+ * where the exact search rarely proves optimality within the time limit.
+ * @param params the parameters of the problem, containing the tonalities, chord degrees, qualities and states for each chord in each progression
+ * @param opts the options for the search. If no cutoff is given, a Luby cutoff scaled on the window size is used. No-goods
+ * are disabled since they are not valid outside of the neighbourhood they were learnt in.
+ * @param print whether to print the improvements of the cost vector over time
+ * @param windowSize the maximum number of consecutive chords relaxed at each restart
+ * @param seed the seed used to pick the neighbourhoods and for the value selection
+ * @return the best solution found, or nullptr if no solution was found
+ * @throws std::invalid_argument if the parameters are invalid (see check_parameters)
+ */
+const FourVoiceTexture* solve_diatony_lns(FourVoiceTextureParameters* params, const Options* opts = nullptr,
+                                          bool print = false, int windowSize = 8, unsigned int seed = 1U);
+
+/**
+ * Returns a good solution to the Four voice texture problem specified by the parameters by decomposing the piece into
+ * its sections. Sections only interact at the modulations, so each section is first solved alone on its own thread,
+ * keeping a small pool of good voicings that differ in the chords at the junctions. A final stitching search then
+ * solves the whole piece, where each section can only take one of its candidate voicings, so that the constraints and
+ * costs at the modulations are taken into account. The solution is not guaranteed to be optimal. If the candidates
+ * cannot be stitched together (e.g. the pivot chords of two sections never match), the whole piece is solved with
+ * solve_diatony. If the stitching search is stopped before its first solution, the best candidates of the sections are
+ * put together as they are, if they form a solution.
+ * @param params the parameters of the problem, containing the tonalities, chord degrees, qualities and states for each chord in each progression
+ * @param opts the options for the search. Only the stop object and the no-goods limit are used by the sub-problems, the
+ * fallback search uses all of them.
+ * @param print whether to print the pools and the stitched solution
+ * @param poolSize the maximum number of candidate voicings kept for each section
+ * @return the best solution found, or nullptr if no solution was found
+ * @throws std::invalid_argument if the parameters are invalid (see check_parameters)
+ */
+const FourVoiceTexture* solve_diatony_decomposed(FourVoiceTextureParameters* params, const Options* opts = nullptr,
+                                                 bool print = false, int poolSize = 8);
+
+/**
+ * Returns the best solution to the Four voice texture problem specified by the parameters, using the voicing index
+ * formulation (see VoicingIndexModel) with the same search as solve_diatony. The piece must contain a single section.
  * @param params the parameters of the problem, containing the tonalities, chord degrees, qualities and states for each chord in each progression
  * @param opts the options for the search, containing the maximum search time, the restart strategy, etc.
  * @param print whether to print the solutions found during the search
  * @return the best solution found, or nullptr if no solution was found
+ * @throws std::invalid_argument if the parameters are invalid (see check_parameters)
  */
-const FourVoiceTexture* solve_diatony(FourVoiceTextureParameters* params, const Options* opts = nullptr, bool print = false);
+const VoicingIndexModel* solve_diatony_voicing_index(FourVoiceTextureParameters* params, const Options* opts = nullptr,
+                                                     bool print = false);
 
 //todo other functions (returning all sols, finding approximately optimal solutions, etc.)
 
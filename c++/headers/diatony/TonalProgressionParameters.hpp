@@ -10,6 +10,55 @@
 #include "../aux/Utilities.hpp"
 #include "../aux/Tonality.hpp"
 
+/**
+ * Read-only view on a sequence of integers owned by another object (e.g. the chord degrees of a progression). It does
+ * not copy the values, so it must not outlive the object that owns them.
+ */
+class IntSpan {
+protected:
+    const int*  first;              // the first value
+    int         length;             // the number of values
+
+public:
+    IntSpan() : first(nullptr), length(0) {}
+
+    IntSpan(const int* first, const int length) : first(first), length(length) {}
+
+    IntSpan(const vector<int>& values) : first(values.data()), length(static_cast<int>(values.size())) {}
+
+    int         operator[](const int i) const   { return first[i]; }
+
+    int         size()                  const   { return length; }
+
+    bool        empty()                 const   { return length == 0; }
+
+    const int*  begin()                 const   { return first; }
+
+    const int*  end()                   const   { return first + length; }
+
+    /**
+     * Returns a view on a part of the sequence
+     * @param offset the position of the first value of the part
+     * @param count the number of values in the part
+     * @return a view on the values [offset, offset + count)
+     */
+    IntSpan     subspan(const int offset, const int count) const { return IntSpan(first + offset, count); }
+};
+
+/**
+ * Read-only structure-of-arrays view of the chords of a progression. Constraint-posting functions take it instead of
+ * copies of the chord vectors, so that building a progression does not allocate memory proportional to its length.
+ * It is obtained with TonalProgressionParameters::get_view, and must not outlive the parameters.
+ */
+struct ProgressionView {
+    const Tonality* tonality;           // the tonality of the progression
+    IntSpan         degrees;            // the degrees of the chords
+    IntSpan         qualities;          // the qualities of the chords
+    IntSpan         states;             // the states of the chords
+
+    int             size()              const   { return degrees.size(); }
+};
+
 /**
  * Class representing all the parameters necessary to create a tonal progression.
  */
@@ -19,7 +68,7 @@ protected:
     const int                       size;                   // The number of chords in the progression
     const int                       start;                  // The position in the global piece at which the progression starts
     const int                       end;                    // The position in the global piece at which the progression ends
-    Tonality*                       tonality;               // The tonality of the progression
+    const Tonality*                 tonality;               // The tonality of the progression
     const vector<int>               chord_degrees;          // The degrees of the chords in the progression
     const vector<int>               chord_qualities;        // The qualities of the chords
     const vector<int>               chord_states;           // The states of the chords
@@ -36,7 +85,7 @@ public:
      * @param chord_quals   The chord qualities
      * @param chord_stas    The chord states
      */
-    TonalProgressionParameters(const int prog_n, const int s, int start, int end, Tonality *t,
+    TonalProgressionParameters(const int prog_n, const int s, int start, int end, const Tonality *t,
                                 vector<int> chord_degs, vector<int> chord_quals, vector<int> chord_stas):
         progression_number(prog_n), size(s), start(start), end(end), tonality(t),
         chord_degrees(std::move(chord_degs)), chord_qualities(std::move(chord_quals)),
@@ -62,13 +111,19 @@ public:
 
     int         get_end()                   const { return end; }
 
-    Tonality *  get_tonality()              const { return tonality; }
+    const Tonality* get_tonality()          const { return tonality; }
 
-    vector<int> get_chordDegrees()          const { return chord_degrees; }
+    const vector<int>& get_chordDegrees()   const { return chord_degrees; }
 
-    vector<int> get_chordQualities()        const { return chord_qualities; }
+    const vector<int>& get_chordQualities() const { return chord_qualities; }
 
-    vector<int> get_chordStates()           const { return chord_states; }
+    const vector<int>& get_chordStates()    const { return chord_states; }
+
+    /**
+     * Returns a read-only view of the chords of the progression, without copying them
+     * @return a view on the tonality, degrees, qualities and states of the progression
+     */
+    ProgressionView get_view() const { return {tonality, chord_degrees, chord_qualities, chord_states}; }
 
     /**
      * to_string method
@@ -0,0 +1,90 @@
+#ifndef VOICINGINDEXMODEL_HPP
+#define VOICINGINDEXMODEL_HPP
+
+#include "ChainModel.hpp"
+#include "FourVoiceTextureParameters.hpp"
+
+/**
+ * This class is an alternative formulation of FourVoiceTexture for pieces with a single section. Instead of one variable
+ * per voice, each chord is a single variable indexing into the list of its legal voicings (see ChainModel). Every pair
+ * of consecutive chords is linked by a single binary transition table that contains all the voice leading rules
+ * (parallel intervals, tritone resolution, contrary motion, prepared sevenths, cadences, ...) and carries the melodic
+ * cost and the number of common notes of the transition. The notes of each voice are channeled from the index with
+ * element constraints.
+ * Interior first inversion chords double their third depending on the motion on both sides, so the index of a chord is
+ * a state 2*voicing + m, where m is 1 if the chord was approached by stepwise contrary motion between the bass and the
+ * soprano (only for those chords, m is always 0 otherwise).
+ */
+class VoicingIndexModel : public IntLexMinimizeSpace {
+protected:
+    int                             nVoices = 4;
+    FourVoiceTextureParameters*     params;                         // The parameters that define the problem
+
+    IntVarArray                     voicingStates;                  // the state of each chord (2*voicing index + motion)
+    IntVarArray                     fullVoicing;                    // The voicing of the chords for the whole piece
+
+    /// cost variables auxiliary arrays
+    IntVarArray                     incompleteChords;               // 1 if the chord is incomplete
+    IntVarArray                     diminishedChordsWith4Notes;     // 1 if the chord is a fundamental state diminished chord with 4 notes
+    IntVarArray                     chordsWithLessThan4Values;      // 1 if the chord has less than 4 different values
+    IntVarArray                     transitionMelodicCosts;         // the melodic cost of each transition
+    IntVarArray                     transitionCommonNotes;          // the number of common notes in the same voice for each transition
+
+    /// cost variables
+    IntVar                          costOfMelodicIntervals;
+    IntVar                          nOfFundStateDiminishedChordsWith4notes;
+    IntVar                          nOfChordsWithLessThan4Values;
+    IntVar                          nOfIncompleteChords;
+    IntVar                          nOfCommonNotesInSameVoice;      // /!\ this cost needs to be maximized, so its value is negative
+
+    IntVarArgs                      costVector;                     // the costs in lexicographical order for minimization
+
+public:
+    /**
+     * Constructor. Enumerates the legal voicings of each chord and the legal transitions between them.
+     * @param params An object containing the parameters for the whole piece. It must contain exactly one section.
+     * @param seed the seed used by the value selection
+     */
+    explicit VoicingIndexModel(FourVoiceTextureParameters* params, unsigned int seed = 1U);
+
+    /**
+     * Copy constructor
+     * @param s A VoicingIndexModel object to copy.
+     */
+    VoicingIndexModel(VoicingIndexModel& s);
+
+    /**                     getters                     **/
+    FourVoiceTextureParameters* getParameters() const { return params; }
+
+    /**
+     * Returns the values of the cost variables in a solution
+     * @return a vector containing the value of each cost in lexicographical order, in the same order as FourVoiceTexture
+     */
+    vector<int> get_cost_values() const;
+
+    /**
+     * Returns the values of the voicing variables in a solution
+     * @return a vector containing the notes of each voice for each chord [bass0, tenor0, alto0, soprano0, bass1, ...]
+     */
+    vector<int> get_voicing_values() const;
+
+    /**
+     * General space copy method
+     * @return a new VoicingIndexModel object that is a copy of this one, as a Space pointer
+     */
+    Space* copy() override;
+
+    /**
+     * Cost function
+     * @return the cost vector containing the cost variables in lexicographical order
+     */
+    IntVarArgs cost() const override;
+
+    /**
+     * to_string method for the VoicingIndexModel object.
+     * @return a string representation of the VoicingIndexModel object
+     */
+    string to_string() const;
+};
+
+#endif //VOICINGINDEXMODEL_HPP
@@ -0,0 +1,45 @@
+#include <csignal>
+#include <pthread.h>
+#include <thread>
+
+#include "../headers/aux/Utilities.hpp"
+#include "../headers/diatony/DiatonyServer.hpp"
+
+/**
+ * Starts a diatony-server (see DiatonyServer) and serves the clients until it receives SIGINT or SIGTERM.
+ * Takes 3 optional arguments:
+ * - the path of the Unix domain socket (/tmp/diatony.sock by default)
+ * - the number of worker threads (one per hardware thread by default)
+ * - the maximum number of solutions kept in the cache (256 by default)
+ */
+int main(int argc, char* argv[]) {
+    const string socketPath = argc > 1 ? argv[1] : "/tmp/diatony.sock";
+    const unsigned int nWorkers = argc > 2 ? std::stoul(argv[2]) : 0;
+    const size_t cacheSize = argc > 3 ? std::stoul(argv[3]) : 256;
+
+    /// the signals are blocked in every thread and handled by a dedicated one, since the server cannot be shut down
+    /// from a signal handler
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    DiatonyServer server(socketPath, nWorkers, cacheSize);
+    std::thread([&server, signals] {
+        int signal;
+        sigwait(&signals, &signal);
+        server.shutdown();
+    }).detach();
+
+    try {
+        std::cout << "diatony-server listening on " << socketPath << std::endl;
+        server.run();
+    }
+    catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -27,26 +27,4 @@ MajorTonality::MajorTonality(int t) : Tonality(t, MAJOR_MODE, MAJOR_SCALE){ // c
     chord_qualities[FIVE_OF_SEVEN]              = DOMINANT_SEVENTH_CHORD;
     chord_qualities[FLAT_TWO]                   = MAJOR_CHORD;
     chord_qualities[AUGMENTED_SIXTH]            = AUGMENTED_SIXTH_CHORD;
-
-    for (int i = 0; i < chord_qualities.size(); i++){
-        //IntSet set(get_all_notes_from_chord(degrees_notes[i], chord_qualities[i]));
-        //scale_degrees_chords[i] = set;
-    }
-}
-
-/**
- * Get the chord quality for each degree
- * @return a map of [degree, chord_quality] for each degree of the scale (0 to 6)
- */
-int MajorTonality:: get_chord_quality(int degree){
-    return chord_qualities[degree];
 }
-
-/**
- * Get the chord notes for a given degree
- * @param degree a degree of the scale [0,6]
- * @return an IntSet containing the chord notes for the given degree
- */
-IntSet MajorTonality::get_scale_degree_chord(int degree){
-    return scale_degrees_chords[degree];
-}
\ No newline at end of file
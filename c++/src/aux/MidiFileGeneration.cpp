@@ -11,6 +11,16 @@
  * @return the time at which the solution ends
  */
 void writeSolToMIDIFile(int size, const string& fileName, const FourVoiceTexture * sol) {
+    writeSolToMIDIFile(size, fileName, sol->get_voicing_values());
+}
+
+/**
+ * Writes a voicing to a MIDI file
+ * @param size the size of the problem
+ * @param fileName the name of the file, without the extension
+ * @param sol_notes the notes of each voice for each chord [bass0, tenor0, alto0, soprano0, bass1, ...]
+ */
+void writeSolToMIDIFile(int size, const string& fileName, const vector<int>& sol_notes) {
     MidiFile outputFile;
     outputFile.absoluteTicks();     // time information stored as absolute time, will be converted to delta time when written
     outputFile.addTrack(1);   // Add a track to the file (track 0 must be left empty, so add as many as we use
@@ -28,7 +38,6 @@ void writeSolToMIDIFile(int size, const string& fileName, const FourVoiceTexture
     vector<uchar> midiEvent;        // temporary storage of MIDI events
     midiEvent.resize(3);        //set the size of the array to 3 bites (first bite = Start or end of a note, second bite = note value, third bite = velocity
 
-    int* sol_notes = sol->return_solution();
     /// Fill the MidiFile object
     midiEvent[2] = 64; // store attack/release velocity for note command
     for(int i = 0; i < size; i++){
@@ -26,27 +26,4 @@ MinorTonality::MinorTonality(int t) : Tonality(t, MINOR_MODE, HARMONIC_MINOR_SCA
     chord_qualities[FIVE_OF_SEVEN]              = DOMINANT_SEVENTH_CHORD;
     chord_qualities[FLAT_TWO]                   = MAJOR_CHORD;
     chord_qualities[AUGMENTED_SIXTH]            = AUGMENTED_SIXTH_CHORD;
-
-    for (int i = 0; i < chord_qualities.size(); i++){
-//        IntSet set(get_all_notes_from_chord(degrees_notes[i], chord_qualities[i]));
-//        scale_degrees_chords[i] = set;
-    }
 }
-
-/**
- * Get the chord quality for each degree
- * @param degree a degree of the scale [0,6]
- * @return the default chord quality for the given degree
- */
-int MinorTonality::get_chord_quality(int degree){
-    return chord_qualities[degree];
-}
-
-/**
- * Get the chord notes for a given degree
- * @param degree a degree of the scale [0,6]
- * @return an IntSet containing the chord notes for the given degree
- */
-IntSet MinorTonality::get_scale_degree_chord(int degree){
-    return scale_degrees_chords[degree];
-}
\ No newline at end of file
@@ -3,6 +3,8 @@
 // Description: A class representing a tonality
 //
 #include "../../headers/aux/Tonality.hpp"
+#include "../../headers/aux/MajorTonality.hpp"
+#include "../../headers/aux/MinorTonality.hpp"
 
 
 /***********************************************************************************************************************
@@ -14,12 +16,12 @@
  * Creates a tonality object based on the tonality (tonic and mode)
  * @param t the tonic of the tonality
  * @param m the mode of the tonality
- * @param s the scale of the tonality
+ * @param s the scale of the tonality, as the N_SCALE_NOTES intervals between its consecutive notes
  */
-Tonality::Tonality(int t, int m, vector<int> s) {
+Tonality::Tonality(int t, int m, const int* s) {
     tonic = t % PERFECT_OCTAVE;    // bring it back to [0,11]
     mode = m;
-    scale = s;
+    std::copy(s, s + N_SCALE_NOTES, scale);
     name = noteNames[tonic] + " " + modeNames[mode];
 
     int note = tonic;
@@ -41,95 +43,46 @@ Tonality::Tonality(int t, int m, vector<int> s) {
     else                    degrees_notes[FIVE_OF_THREE] = note                      % PERFECT_OCTAVE;
     degrees_notes[AUGMENTED_SIXTH]              = (tonic + MINOR_SIXTH)              % PERFECT_OCTAVE;
 
-    tonal_notes = {degrees_notes[FIRST_DEGREE], degrees_notes[FOURTH_DEGREE], degrees_notes[FIFTH_DEGREE]};
+    tonal_notes = 1 << degrees_notes[FIRST_DEGREE] | 1 << degrees_notes[FOURTH_DEGREE] | 1 << degrees_notes[FIFTH_DEGREE];
     /// Modal notes are the notes that change in major or minor scale (3,6,7 degrees). For simplicity for constraints,
     /// All notes that are not tonal are considered modal (useful for doubling)
-    for(int i = 0; i < PERFECT_OCTAVE; i++){
-        if(tonal_notes.find(i) == tonal_notes.end())
-            modal_notes.insert(i);
-    }
-    /// The rest of the attributes are set by the child classes
-}
-
-string Tonality::get_name() const {
-    return name;
-}
-
-/**
- * Get the tonic of the tonality
- * @return the tonic of the tonality
- */
-int Tonality::get_tonic() const {
-    return tonic;
-}
-
-/**
- * Get the mode of the tonality
- * @return the mode of the tonality
- */
-int Tonality::get_mode() const{
-    return mode;
-}
-
-/**
- * Get the scale of the tonality
- * @return the scale of the tonality
- */
-vector<int> Tonality::get_scale() {
-    return scale;
-}
-
-/**
- * Get the note on which the chord is built for a given degree
- * @param degree the degree of the scale [0,6]
- * @return the note for the given degree
- */
-int Tonality::get_degree_note(int degree){
-    return degrees_notes[degree];
-}
-
-/**
- * Get all the notes for each scale degree
- * @return a map of [degree, all_notes] for each degree of the scale (0 to 6)
- */
-map<int, IntSet> Tonality::get_scale_degrees() {
-    return scale_degrees;
-}
-
-/**
- * Get all the notes for a given scale degree
- * @param degree a degree of the scale [0,6]
- * @return an IntSet containing all the notes for the given scale degree
- */
-IntSet Tonality::get_scale_degree(int degree) {
-    return scale_degrees[degree];
-}
-
-/**
- * Get the notes that don't change in major or minor scale (1,4,5 degrees)
- * @return an IntSet containing the tonal notes
- */
-set<int> Tonality::get_tonal_notes() {
-    return tonal_notes;
+    modal_notes = ~tonal_notes & (N_PITCH_CLASS_MASKS - 1);
+    /// The chord qualities are set by the child classes
+    std::fill(chord_qualities, chord_qualities + N_DEGREES, MAJOR_CHORD);
 }
 
 /**
- * Get the notes that change in major or minor scale (3,6,7 degrees)
- * @return an IntSet containing the modal notes
+ * Returns the tonality with the given tonic and mode, shared by the whole process. The 24 major and minor
+ * tonalities are built once on first use, and this function is thread-safe. The returned tonality must not be
+ * deleted.
+ * @param tonic the tonic of the tonality
+ * @param mode the mode of the tonality (MAJOR_MODE or MINOR_MODE)
+ * @return the tonality with the given tonic and mode
  */
-set<int> Tonality::get_modal_notes() {
-    return modal_notes;
+const Tonality* Tonality::get_tonality(const int tonic, const int mode) {
+    if (mode != MAJOR_MODE && mode != MINOR_MODE)
+        throw std::invalid_argument("Only major and minor tonalities are supported. Mode: " + std::to_string(mode));
+    /// the initialization of a local static variable is thread-safe, so the tonalities are built exactly once
+    static const vector<const Tonality*> tonalities = [] {
+        vector<const Tonality*> all;
+        for (int t = 0; t < PERFECT_OCTAVE; t++) {
+            all.push_back(new MajorTonality(t));
+            all.push_back(new MinorTonality(t));
+        }
+        return all;
+    }();
+    return tonalities[2 * (((tonic % PERFECT_OCTAVE) + PERFECT_OCTAVE) % PERFECT_OCTAVE) + (mode == MINOR_MODE)];
 }
 
 /**
  * @return a string representing a tonality
  */
-string Tonality::to_string() {
+string Tonality::to_string() const {
     string t;
     t += "Name: " + name + "\n";
     t += "Tonic: " + std::to_string(tonic) + "(" + noteNames[tonic] + ")\n";
     t += "Mode: " + std::to_string(mode) + "(" + modeNames[mode] + ")\n";
-    t += "Scale: " + int_vector_to_string(scale) + "\n";
+    t += "Scale: " + int_vector_to_string(vector<int>(scale, scale + N_SCALE_NOTES)) + "\n";
 
     t+= "Default chord qualities: ";
     for(int i = FIRST_DEGREE; i <= AUGMENTED_SIXTH; i++)
@@ -142,13 +95,14 @@ string Tonality::to_string() {
     t += "\n";
 
     t += "Tonal notes: ";
-    for (auto elem: tonal_notes)
-        t += std::to_string(elem) + " ";
+    for (int note = 0; note < PERFECT_OCTAVE; note++)
+        if (is_tonal_note(note))
+            t += std::to_string(note) + " ";
 
     return t;
 }
 
-string Tonality::pretty() {
+string Tonality::pretty() const {
     string t;
     t += "Name: " + name + "\n";
 
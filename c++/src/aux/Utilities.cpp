@@ -11,18 +11,13 @@
  * @return
  */
 vector<int> get_all_notes_in_chord(int root, int quality) {
-    /// get the intervals constituting the chord
-    auto intervals = chordQualitiesIntervals.at(quality);
     /// bring back the note to [0,11]
-    int note = root % PERFECT_OCTAVE;
+    const int note = root % PERFECT_OCTAVE;
 
     vector<int> notes, chord_notes;
-    /// add the note to the chord notes
-    notes.push_back(note);
-    /// add the other notes in the chord
-    for (auto interval : intervals) {
-        notes.push_back((note += interval) % PERFECT_OCTAVE);
-    }
+    /// the root and the other notes in the chord
+    for (int chordNote = ROOT; chordNote < get_number_of_notes_in_chord(quality); chordNote++)
+        notes.push_back((note + get_interval_from_root(quality, chordNote)) % PERFECT_OCTAVE);
     /// for each note in the chord, add all the notes in the range [0,127]
     for (int n : notes) {
         int curr_note = n;
@@ -51,23 +46,6 @@ vector<int> get_all_given_note(int note)
     return notes;
 }
 
-/**
- * Get the interval in semitones between the root and
- * @param quality the quality of the chord
- * @param chordNote the rank of the note in the chord (fundamental, third, fifth, etc.)
- * @return the interval in semitones between the root and the note
- */
-int get_interval_from_root(int quality, int chordNote){
-    const auto& intervals = chordQualitiesIntervals.at(quality); // the intervals between consecutive notes in the chord
-    int diff = 0; // the difference between the bass and the fundamental in semitones
-    int s = 0; // variable to iterate over notes
-    while (s < chordNote){
-        diff += intervals[s];
-        s++;
-    }
-    return diff;
-}
-
 /**
  * Transforms a vector of integers into a string
  * @param vector a vector of integers
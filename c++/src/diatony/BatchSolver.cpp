@@ -0,0 +1,201 @@
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "../../headers/diatony/BatchSolver.hpp"
+#include "../../headers/diatony/SolveDiatony.hpp"
+
+const vector<string> batch_job_status_names = {"Solved", "No solution", "Invalid", "Expired", "Error", "Cancelled"};
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * The jobs waiting for a worker. The owner takes its jobs from the front, the other workers steal from the back.
+     */
+    class JobQueue {
+    protected:
+        std::deque<int>     jobs;       // the indices of the jobs
+        std::mutex          lock;
+
+    public:
+        void push(const int job) {
+            std::lock_guard<std::mutex> guard(lock);
+            jobs.push_back(job);
+        }
+
+        /**
+         * Removes a job from the queue
+         * @param steal whether the job is taken by another worker than the owner of the queue
+         * @return the index of the job, or -1 if the queue is empty
+         */
+        int pop(const bool steal) {
+            std::lock_guard<std::mutex> guard(lock);
+            if (jobs.empty())
+                return -1;
+            int job;
+            if (steal) {
+                job = jobs.back();
+                jobs.pop_back();
+            }
+            else {
+                job = jobs.front();
+                jobs.pop_front();
+            }
+            return job;
+        }
+    };
+
+    /**
+     * Stop object of a job. The search stops when the time budget of the job is spent, or when the stop object of the
+     * batch says so.
+     */
+    class JobStop : public Search::Stop {
+    protected:
+        Search::Stop*       timeStop;       // the time budget of the job, owned by this object
+        CancellableStop*    batchStop;      // the stop object of the batch (can be nullptr)
+    public:
+        JobStop(const double timeLimit, CancellableStop* batchStop) :
+            timeStop(Search::Stop::time(timeLimit)), batchStop(batchStop) {}
+
+        JobStop(const JobStop&) = delete;
+
+        JobStop& operator=(const JobStop&) = delete;
+
+        ~JobStop() override { delete timeStop; }
+
+        bool stop(const Search::Statistics& s, const Search::Options& o) override {
+            return (batchStop != nullptr && batchStop->stop(s, o)) || timeStop->stop(s, o);
+        }
+    };
+
+    /**
+     * Returns the number of milliseconds elapsed since a time point
+     * @param start the time point
+     * @return the elapsed time in milliseconds
+     */
+    double elapsed_ms(const Clock::time_point& start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+}
+
+/**
+ * Constructor
+ * @param nWorkers the number of worker threads. If it is 0, one worker per hardware thread is used.
+ * @param defaultTimeLimit the time budget of the jobs that do not have one, in milliseconds
+ * @param deadline the time limit of the whole batch in milliseconds, or a negative value if there is none
+ */
+BatchSolver::BatchSolver(const unsigned int nWorkers, const double defaultTimeLimit, const double deadline) :
+    nWorkers(nWorkers != 0 ? nWorkers : std::max(1U, std::thread::hardware_concurrency())),
+    defaultTimeLimit(defaultTimeLimit), deadline(deadline) {
+    if (defaultTimeLimit < 0)
+        throw std::invalid_argument("The default time limit cannot be negative, got " +
+            std::to_string(defaultTimeLimit));
+}
+
+/**
+ * Solves the jobs on the pool of workers
+ * @param jobs the problems to solve
+ * @param onResult called with the index of each job and its result, never by two threads at the same time
+ * @param stop stops the jobs when it is cancelled or one of its limits is reached (can be nullptr)
+ */
+void BatchSolver::run(const vector<BatchJob>& jobs, const std::function<void(int, BatchResult&&)>& onResult,
+                      CancellableStop* stop) const {
+    const int nJobs = static_cast<int>(jobs.size());
+    const int nThreads = std::min(static_cast<int>(nWorkers), nJobs);
+    if (nThreads == 0)
+        return;
+    const Clock::time_point start = Clock::now();
+
+    /// deal the jobs in contiguous blocks, so that stolen jobs are far from the ones the owner is working on
+    vector<JobQueue> queues(nThreads);
+    for (int i = 0; i < nJobs; i++)
+        queues[static_cast<long long>(i) * nThreads / nJobs].push(i);
+
+    std::mutex reportLock;
+    auto worker = [&](const int self) {
+        while (true) {
+            int job = queues[self].pop(false);
+            for (int other = 1; job < 0 && other < nThreads; other++)
+                job = queues[(self + other) % nThreads].pop(true);
+            /// no job is added while the batch runs, so empty queues mean that all the jobs are taken
+            if (job < 0)
+                return;
+
+            const Clock::time_point jobStart = Clock::now();
+            BatchResult result;
+            result.id = jobs[job].id;
+            double timeLimit = jobs[job].timeLimit >= 0 ? jobs[job].timeLimit : defaultTimeLimit;
+            if (deadline >= 0)
+                timeLimit = std::min(timeLimit, deadline - elapsed_ms(start));
+            if (stop != nullptr && stop->is_cancelled()) {
+                result.status = JOB_CANCELLED;
+            }
+            else if (timeLimit <= 0) {
+                result.status = JOB_EXPIRED;
+            }
+            else {
+                try {
+                    const DiatonySnapshot snapshot(jobs[job].params, jobs[job].variableSelection,
+                        jobs[job].valueSelection);
+                    /// same search as solve_diatony without options, also stopped by the stop object of the batch
+                    JobStop jobStop(timeLimit, stop);
+                    Options options;
+                    options.threads = 1;
+                    options.stop = &jobStop;
+                    options.nogoods_limit = jobs[job].params->get_totalNumberOfChords() * 4 * 4;
+                    result.solution = solve_diatony(snapshot, &options, false, timeLimit);
+                    if (stop != nullptr && stop->is_cancelled())
+                        result.status = JOB_CANCELLED;
+                    else
+                        result.status = result.solution.found() ? JOB_SOLVED : JOB_NO_SOLUTION;
+                }
+                catch (const std::invalid_argument& e) {
+                    result.status = JOB_INVALID;
+                    result.error = e.what();
+                }
+                catch (const std::exception& e) {
+                    result.status = JOB_ERROR;
+                    result.error = e.what();
+                }
+            }
+            result.time = elapsed_ms(jobStart);
+
+            std::lock_guard<std::mutex> guard(reportLock);
+            onResult(job, std::move(result));
+        }
+    };
+
+    vector<std::thread> threads;
+    for (int w = 1; w < nThreads; w++)
+        threads.emplace_back(worker, w);
+    worker(0);
+    for (auto& thread : threads)
+        thread.join();
+}
+
+/**
+ * Solves the jobs and reports their results as soon as they finish, in the order in which they finish. The callback is
+ * never called by two threads at the same time. This function returns when all the jobs are reported.
+ * @param jobs the problems to solve
+ * @param onResult called with the result of each job
+ * @param stop stops the jobs when it is cancelled or one of its limits is reached (can be nullptr). Once it is
+ * cancelled, the jobs that have not started are reported as cancelled.
+ */
+void BatchSolver::solve(const vector<BatchJob>& jobs, const std::function<void(const BatchResult&)>& onResult,
+                        CancellableStop* stop) const {
+    run(jobs, [&onResult](int, BatchResult&& result) { onResult(result); }, stop);
+}
+
+/**
+ * Solves the jobs and returns their results
+ * @param jobs the problems to solve
+ * @param stop stops the jobs when it is cancelled or one of its limits is reached (can be nullptr). Once it is
+ * cancelled, the jobs that have not started are reported as cancelled.
+ * @return the results of the jobs, in the order of the jobs
+ */
+vector<BatchResult> BatchSolver::solve(const vector<BatchJob>& jobs, CancellableStop* stop) const {
+    vector<BatchResult> results(jobs.size());
+    run(jobs, [&results](const int job, BatchResult&& result) { results[job] = std::move(result); }, stop);
+    return results;
+}
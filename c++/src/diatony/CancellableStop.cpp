@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <limits>
+#include <sys/resource.h>
+
+#include "../../headers/diatony/CancellableStop.hpp"
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    /// the memory of the process is only measured once every this many calls, as it needs a system call
+    constexpr unsigned int MEMORY_CHECK_PERIOD = 256;
+
+    /**
+     * Stop object limiting the peak resident set size of the process. It can be shared by several engines.
+     */
+    class MemoryStop : public Search::Stop {
+    protected:
+        size_t                      limit;      // in bytes
+        std::atomic<unsigned int>   calls;
+        std::atomic<bool>           exceeded;
+
+    public:
+        explicit MemoryStop(const size_t limit) : limit(limit), calls(0), exceeded(false) {}
+
+        bool stop(const Search::Statistics&, const Search::Options&) override {
+            if (exceeded.load(std::memory_order_relaxed))
+                return true;
+            if (calls.fetch_add(1, std::memory_order_relaxed) % MEMORY_CHECK_PERIOD != 0)
+                return false;
+            struct rusage usage;
+            if (getrusage(RUSAGE_SELF, &usage) != 0)
+                return false;
+#ifdef __APPLE__
+            const size_t peak = static_cast<size_t>(usage.ru_maxrss);           // in bytes on macOS
+#else
+            const size_t peak = static_cast<size_t>(usage.ru_maxrss) * 1024;    // in kilobytes on Linux
+#endif
+            if (peak > limit)
+                exceeded.store(true);
+            return peak > limit;
+        }
+    };
+}
+
+/**
+ * Constructor for a stop object with a time limit
+ * @param timeLimit the time limit in milliseconds, counted from the construction of the object
+ */
+CancellableStop::CancellableStop(const double timeLimit) :
+    cancelled(false), deadline(Clock::time_point::max()) {
+    time_limit(timeLimit);
+}
+
+CancellableStop::~CancellableStop() {
+    for (auto limit : limits)
+        delete limit;
+}
+
+/**
+ * Adds a limit to the search
+ * @param limit a stop object, which is deleted with this object
+ * @return this object
+ */
+CancellableStop& CancellableStop::add(Search::Stop* limit) {
+    if (limit == nullptr)
+        throw std::invalid_argument("The limit of a stop object cannot be null");
+    limits.push_back(limit);
+    return *this;
+}
+
+/**
+ * Adds a time limit
+ * @param timeLimit the time limit in milliseconds, counted from now
+ * @return this object
+ */
+CancellableStop& CancellableStop::time_limit(const double timeLimit) {
+    const auto end = Clock::now() +
+        std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(timeLimit));
+    deadline = std::min(deadline, end);
+    return add(Search::Stop::time(timeLimit));
+}
+
+/**
+ * @return the time left before the earliest time limit in milliseconds (negative once it is reached), or infinity if
+ * there is no time limit
+ */
+double CancellableStop::remaining_time() const {
+    if (deadline == Clock::time_point::max())
+        return std::numeric_limits<double>::infinity();
+    return std::chrono::duration<double, std::milli>(deadline - Clock::now()).count();
+}
+
+/**
+ * Adds a limit on the memory used by the process. The peak resident set size of the process is measured, so the
+ * search stops once it exceeded the limit, even if the memory has been released since.
+ * @param bytes the maximum resident set size of the process in bytes
+ * @return this object
+ */
+CancellableStop& CancellableStop::memory_limit(const size_t bytes) {
+    return add(new MemoryStop(bytes));
+}
+
+/**
+ * @return true if the search was cancelled or one of its limits was reached
+ */
+bool CancellableStop::stop(const Search::Statistics& s, const Search::Options& o) {
+    if (cancelled.load(std::memory_order_relaxed))
+        return true;
+    for (auto limit : limits) {
+        if (limit->stop(s, o))
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,499 @@
+#include "../../headers/diatony/ChainModel.hpp"
+
+/// cost of each melodic interval by its absolute size in semitones, same weights as compute_cost_for_melodic_intervals
+static const int melodicIntervalCosts[PERFECT_OCTAVE + 1] = {
+    UNISON_COST, SECOND_COST, SECOND_COST, THIRD_COST, THIRD_COST, FOURTH_COST, TRITONE_COST, FIFTH_COST,
+    SIXTH_COST, SIXTH_COST, SEVENTH_COST, SEVENTH_COST, OCTAVE_COST
+};
+
+/**
+ * Returns the number of voices playing a given note (regardless of the octave)
+ * @param voicing the voicing of a chord
+ * @param note a note in [0,11]
+ * @return the number of voices playing the note
+ */
+static int count_note(const ChordVoicing& voicing, const int note) {
+    int n = 0;
+    for (const int v : voicing)
+        if (v % PERFECT_OCTAVE == note)
+            n++;
+    return n;
+}
+
+/**
+ * Returns the number of different values in a voicing
+ * @param voicing the voicing of a chord, in increasing order
+ * @return the number of different values
+ */
+static int count_values(const ChordVoicing& voicing) {
+    int n = 1;
+    for (int v = TENOR; v <= SOPRANO; v++)
+        if (voicing[v] != voicing[v - 1])
+            n++;
+    return n;
+}
+
+/**
+ * Returns the number of different notes (regardless of their octave) in a voicing
+ * @param voicing the voicing of a chord
+ * @return the number of different notes
+ */
+static int count_notes(const ChordVoicing& voicing) {
+    int mask = 0;
+    for (const int v : voicing)
+        mask |= 1 << (v % PERFECT_OCTAVE);
+    int n = 0;
+    for (; mask != 0; mask &= mask - 1)
+        n++;
+    return n;
+}
+
+/**
+ * Returns whether the degree is a dominant chord (fifth degree or secondary dominant)
+ * @param degree a chord degree
+ * @return true if the chord is a dominant chord
+ */
+static bool is_dominant(const int degree) {
+    return degree == FIFTH_DEGREE || (degree >= FIVE_OF_TWO && degree <= FIVE_OF_SEVEN);
+}
+
+/**
+ * Returns whether the doubling of a first inversion chord is decided by the motion of the bass and the soprano, that
+ * is when its third is not doubled by a fixed rule (see double_third_on_contrary_motion)
+ * @param tonality the tonality of the chord
+ * @param degree the degree of the chord
+ * @param quality the quality of the chord
+ * @return true if the default doubling rule applies
+ */
+bool ChainModel::default_first_inversion_doubling(const Tonality* tonality, const int degree, const int quality) {
+    const int root = tonality->get_degree_note(degree);
+    const int third = (root + get_interval_from_root(quality, THIRD)) % PERFECT_OCTAVE;
+    if (tonality->is_tonal_note(third))
+        return false;
+    if ((degree == SEVENTH_DEGREE && quality == DIMINISHED_CHORD) || degree == FLAT_TWO)
+        return false;
+    if (is_dominant(degree) && quality == DIMINISHED_SEVENTH_CHORD)
+        return false;
+    return true;
+}
+
+/**
+ * Constructor. Enumerates the legal voicings of each chord.
+ * @param params the parameters of the progression
+ */
+ChainModel::ChainModel(TonalProgressionParameters* params) : params(params) {
+    tonality    = params->get_tonality();
+    size        = params->get_size();
+    degrees     = params->get_chordDegrees();
+    qualities   = params->get_chordQualities();
+    states      = params->get_chordStates();
+
+    /// chords
+    for (int i = 0; i < size; i++) {
+        const int variant = chord_variant(params, i);
+        voicings.push_back(enumerate_voicings(tonality, degrees[i], qualities[i], states[i], variant));
+
+        vector<CostVector> costs;
+        costs.reserve(voicings[i].size());
+        for (const auto& v : voicings[i])
+            costs.push_back(chord_cost(qualities[i], states[i], v));
+        chordCosts.push_back(costs);
+
+        motionDependent.push_back(variant == INTERIOR_CHORD_VARIANT &&
+            default_first_inversion_doubling(tonality, degrees[i], qualities[i]));
+        thirds.push_back((tonality->get_degree_note(degrees[i]) + get_interval_from_root(qualities[i], THIRD)) % PERFECT_OCTAVE);
+    }
+
+    /// transitions, the rules are selected in the same order as in TonalProgression
+    for (int i = 0; i < size - 1; i++) {
+        tritoneResolution.push_back(
+            (degrees[i] == SEVENTH_DEGREE && qualities[i] == DIMINISHED_CHORD && degrees[i + 1] == FIRST_DEGREE) ||
+            (degrees[i] == FIFTH_DEGREE && degrees[i + 1] == FIRST_DEGREE) ||
+            (degrees[i] >= FIVE_OF_TWO && degrees[i] <= FIVE_OF_SEVEN && degrees[i + 1] != FIFTH_DEGREE_APPOGIATURA));
+
+        int rule = GENERAL_RULES;
+        if (degrees[i] == FIFTH_DEGREE && states[i] == FUNDAMENTAL_STATE &&
+            degrees[i + 1] == SIXTH_DEGREE && states[i + 1] == FUNDAMENTAL_STATE)
+            rule = INTERRUPTED_CADENCE_RULES;
+        else if (degrees[i] == AUGMENTED_SIXTH)
+            rule = ITALIAN_SIXTH_RULES;
+        else if (degrees[i] == FIRST_DEGREE && states[i] == SECOND_INVERSION && degrees[i + 1] == FIFTH_DEGREE &&
+            (qualities[i] == MAJOR_CHORD || qualities[i] == DOMINANT_SEVENTH_CHORD))
+            rule = APPOGGIATURA_RULES;
+        transitionRules.push_back(rule);
+
+        int seventh = -1;
+        bool contrary = false;
+        if (rule == GENERAL_RULES) {
+            /// same condition as in TonalProgression (the quality is compared to SEVENTH_DEGREE)
+            if ((qualities[i + 1] == MAJOR_SEVENTH_CHORD || qualities[i + 1] == MINOR_SEVENTH_CHORD ||
+                qualities[i + 1] == DIMINISHED_SEVENTH_CHORD || qualities[i + 1] == HALF_DIMINISHED_CHORD) &&
+                qualities[i + 1] <= SEVENTH_DEGREE)
+                seventh = (tonality->get_degree_note(degrees[i + 1]) +
+                    get_interval_from_root(qualities[i + 1], SEVENTH)) % PERFECT_OCTAVE;
+
+            const int bassFirstChord = tonality->get_degree_note(degrees[i] + 2 * states[i]) % PERFECT_OCTAVE;
+            const int bassSecondChord = tonality->get_degree_note(degrees[i + 1] + 2 * states[i + 1]) % PERFECT_OCTAVE;
+            const int bassMelodicMotion = abs(bassSecondChord - bassFirstChord);
+            contrary = ((bassMelodicMotion == MINOR_SECOND || bassMelodicMotion == MAJOR_SECOND ||
+                         bassMelodicMotion == MINOR_SEVENTH || bassMelodicMotion == MAJOR_SEVENTH) &&
+                        states[i] == FUNDAMENTAL_STATE && states[i + 1] == FUNDAMENTAL_STATE) ||
+                       (degrees[i] == SECOND_DEGREE && degrees[i + 1] == FIFTH_DEGREE);
+        }
+        preparedSeventh.push_back(seventh);
+        contraryMotion.push_back(contrary);
+    }
+    /// the appoggiatura rules also constrain how the I64 chord is approached
+    for (int i = 0; i < size - 1; i++)
+        appoggiaturaApproach.push_back(i + 1 < size - 1 && transitionRules[i + 1] == APPOGGIATURA_RULES);
+}
+
+/**
+ * Returns the number of times the third of a chord is present in one of its voicings
+ * @param chord the position of the chord
+ * @param voicing the voicing of the chord
+ * @return the number of voices playing the third of the chord
+ */
+int ChainModel::count_thirds(const int chord, const ChordVoicing& voicing) const {
+    return count_note(voicing, thirds[chord]);
+}
+
+/**
+ * Checks all the rules between two consecutive chords, except the doubling of motion dependent chords
+ * @param i the position of the first chord
+ * @param current the voicing of chord i
+ * @param next the voicing of chord i+1
+ * @return true if the transition is legal, false otherwise
+ */
+bool ChainModel::is_legal_transition(const int i, const ChordVoicing& current, const ChordVoicing& next) const {
+    /// melodic intervals are at most an octave
+    for (int v = BASS; v <= SOPRANO; v++)
+        if (abs(next[v] - current[v]) > PERFECT_OCTAVE)
+            return false;
+
+    /// parallel fifths, octaves and unisons are forbidden in the whole piece (see forbid_parallel_intervals)
+    for (int lower = BASS; lower < SOPRANO; lower++) {
+        for (int upper = lower + 1; upper <= SOPRANO; upper++) {
+            const int interval = (current[upper] - current[lower]) % PERFECT_OCTAVE;
+            if ((interval == PERFECT_FIFTH || interval == UNISON) &&
+                (next[upper] - next[lower]) % PERFECT_OCTAVE == interval &&
+                !(current[lower] == next[lower] && current[upper] == next[upper]))
+                return false;
+        }
+    }
+
+    if (tritoneResolution[i] && !respects_tritone_resolution(i, current, next))
+        return false;
+
+    if (!respects_transition_rules(i, current, next))
+        return false;
+
+    /// approach of the appoggiatura (fifth_degree_appogiatura, posted on the next chord)
+    if (appoggiaturaApproach[i]) {
+        /// if the bass rises, a voice playing the tonic must go down or stay the same
+        if (next[BASS] - current[BASS] >= 0) {
+            for (int v = TENOR; v <= SOPRANO; v++)
+                if (next[v] % PERFECT_OCTAVE == tonality->get_tonic() && next[v] - current[v] > 0)
+                    return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Checks the tritone resolution rules between two chords
+ * @param i the position of the first chord
+ * @param current the voicing of the first chord
+ * @param next the voicing of the second chord
+ * @return true if the rules are respected, false otherwise
+ */
+bool ChainModel::respects_tritone_resolution(const int i, const ChordVoicing& current, const ChordVoicing& next) const {
+    if (degrees[i] == FIFTH_DEGREE || degrees[i] == SEVENTH_DEGREE) {
+        const bool fourthRises =
+            (degrees[i] == SEVENTH_DEGREE && states[i] == FIRST_INVERSION &&
+             degrees[i + 1] == FIRST_DEGREE && states[i + 1] == FIRST_INVERSION) ||
+            (degrees[i] == FIFTH_DEGREE && qualities[i] == DOMINANT_SEVENTH_CHORD && states[i] == SECOND_INVERSION &&
+             degrees[i + 1] == FIRST_DEGREE && states[i + 1] == FIRST_INVERSION);
+        const int fourth = (tonality->get_tonic() + PERFECT_FOURTH) % PERFECT_OCTAVE;
+        const int leadingTone = (tonality->get_tonic() + MAJOR_SEVENTH) % PERFECT_OCTAVE;
+        for (int v = BASS; v <= SOPRANO; v++) {
+            const int interval = next[v] - current[v];
+            if (current[v] % PERFECT_OCTAVE == fourth) {
+                if (fourthRises && !(interval > 0 && interval <= 2))
+                    return false;
+                if (!fourthRises && !(interval < 0 && interval >= -2))
+                    return false;
+            }
+            if (current[v] % PERFECT_OCTAVE == leadingTone && interval != 1)
+                return false;
+        }
+    }
+    else { /// secondary dominant chords
+        const int third = (tonality->get_degree_note(degrees[i]) + MAJOR_THIRD) % PERFECT_OCTAVE;
+        const int seventh = (tonality->get_degree_note(degrees[i]) + MINOR_SEVENTH) % PERFECT_OCTAVE;
+        for (int v = BASS; v <= SOPRANO; v++) {
+            const int interval = next[v] - current[v];
+            if (current[v] % PERFECT_OCTAVE == seventh && !(interval < 0 && interval >= -2))
+                return false;
+            if (current[v] % PERFECT_OCTAVE == third && interval != 1)
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Checks the special rules of the transition (interrupted cadence, augmented sixth, appoggiatura, or the general
+ * voice leading rules)
+ * @param i the position of the first chord
+ * @param current the voicing of the first chord
+ * @param next the voicing of the second chord
+ * @return true if the rules are respected, false otherwise
+ */
+bool ChainModel::respects_transition_rules(const int i, const ChordVoicing& current, const ChordVoicing& next) const {
+    ChordVoicing intervals;
+    for (int v = BASS; v <= SOPRANO; v++)
+        intervals[v] = next[v] - current[v];
+
+    switch (transitionRules[i]) {
+        case INTERRUPTED_CADENCE_RULES: {
+            const int leadingTone = (tonality->get_tonic() + MAJOR_SEVENTH) % PERFECT_OCTAVE;
+            if (current[SOPRANO] % PERFECT_OCTAVE == leadingTone &&
+                (intervals[SOPRANO] != 1 || intervals[TENOR] >= 0 || intervals[ALTO] >= 0))
+                return false;
+            if (tonality->get_mode() == MINOR_MODE) {
+                const int seventhDegree = tonality->get_degree_note(SEVENTH_DEGREE);
+                if (current[TENOR] % PERFECT_OCTAVE == leadingTone && (intervals[TENOR] != 1 || intervals[ALTO] >= 0))
+                    return false;
+                if (current[TENOR] % PERFECT_OCTAVE == seventhDegree && intervals[SOPRANO] >= 0)
+                    return false;
+                if (current[ALTO] % PERFECT_OCTAVE == seventhDegree &&
+                    (intervals[ALTO] != 1 || intervals[TENOR] >= 0 || intervals[SOPRANO] >= 0))
+                    return false;
+            }
+            return true;
+        }
+        case ITALIAN_SIXTH_RULES: {
+            const int sixth = (tonality->get_degree_note(AUGMENTED_SIXTH) + MINOR_SIXTH) % PERFECT_OCTAVE;
+            for (int v = TENOR; v <= SOPRANO; v++) {
+                if (current[v] % PERFECT_OCTAVE == tonality->get_tonic() &&
+                    intervals[v] != -MINOR_SECOND && intervals[v] != MAJOR_SECOND)
+                    return false;
+                if (current[v] % PERFECT_OCTAVE == sixth && intervals[v] != -MINOR_SECOND)
+                    return false;
+            }
+            return true;
+        }
+        case APPOGGIATURA_RULES: {
+            const int third = tonality->get_degree_note(THIRD_DEGREE);
+            for (int v = TENOR; v <= SOPRANO; v++) {
+                if (current[v] % PERFECT_OCTAVE == tonality->get_tonic() && intervals[v] != -MINOR_SECOND)
+                    return false;
+                if (current[v] % PERFECT_OCTAVE == third && !(intervals[v] < UNISON && intervals[v] >= -MAJOR_SECOND))
+                    return false;
+            }
+            return true;
+        }
+        default: {
+            /// the seventh must be prepared
+            if (preparedSeventh[i] != -1) {
+                for (int v = BASS; v <= SOPRANO; v++)
+                    if ((current[v] % PERFECT_OCTAVE == preparedSeventh[i]) != (next[v] % PERFECT_OCTAVE == preparedSeventh[i]))
+                        return false;
+            }
+            /// the upper voices move in contrary motion to the bass
+            if (contraryMotion[i]) {
+                for (int v = TENOR; v <= SOPRANO; v++) {
+                    if ((intervals[BASS] > 0) != (intervals[v] < 0) || (intervals[BASS] < 0) != (intervals[v] > 0))
+                        return false;
+                }
+            }
+            return true;
+        }
+    }
+}
+
+/**
+ * Returns the cost of moving from a voicing to the next one (melodic intervals and common notes)
+ * @param current the voicing of the first chord
+ * @param next the voicing of the second chord
+ * @return the costs of the transition
+ */
+CostVector ChainModel::transition_cost(const ChordVoicing& current, const ChordVoicing& next) {
+    CostVector costs = {0, 0, 0, 0, 0};
+    for (int v = BASS; v <= SOPRANO; v++) {
+        const int interval = abs(next[v] - current[v]);
+        costs[3] += melodicIntervalCosts[interval];
+        if (interval == UNISON)
+            costs[4] -= 1;
+    }
+    return costs;
+}
+
+/**
+ * Returns the costs of a voicing of a chord (incomplete chord, diminished chord with 4 notes, less than 4 values)
+ * @param quality the quality of the chord
+ * @param state the state of the chord
+ * @param voicing the voicing of the chord
+ * @return the costs of the chord
+ */
+CostVector ChainModel::chord_cost(const int quality, const int state, const ChordVoicing& voicing) {
+    const int nOfNotesInChord = get_number_of_notes_in_chord(quality);
+    const int nValues = count_values(voicing);
+    CostVector costs = {0, 0, 0, 0, 0};
+    costs[0] = count_notes(voicing) != nOfNotesInChord;
+    costs[1] = quality == DIMINISHED_CHORD && state == FUNDAMENTAL_STATE && nValues == 4;
+    costs[2] = nValues < 4;
+    return costs;
+}
+
+/**
+ * Returns whether the bass rises and the soprano falls by step between two voicings
+ * @param current the voicing of the first chord
+ * @param next the voicing of the second chord
+ * @return true if the bass rises by step and the soprano falls by step
+ */
+bool ChainModel::stepwise_contrary_motion(const ChordVoicing& current, const ChordVoicing& next) {
+    const int bass = next[BASS] - current[BASS];
+    const int soprano = next[SOPRANO] - current[SOPRANO];
+    return bass > 0 && bass <= 2 && soprano < 0 && soprano >= -2;
+}
+
+/**
+ * Returns the variant of a chord, that is the information about its neighbours that the rules on its own notes
+ * depend on
+ * @param params the parameters of the progression
+ * @param chord the position of the chord
+ * @return the variant of the chord (see chord_variants)
+ */
+int ChainModel::chord_variant(const TonalProgressionParameters* params, const int chord) {
+    const vector<int>& degrees = params->get_chordDegrees();
+    const vector<int>& states = params->get_chordStates();
+    if (states[chord] == FUNDAMENTAL_STATE && degrees[chord] == SIXTH_DEGREE && chord > 0 &&
+        degrees[chord - 1] == FIFTH_DEGREE)
+        return AFTER_FIFTH_DEGREE_VARIANT;
+    if (states[chord] == FIRST_INVERSION && chord > 0 && chord < params->get_size() - 1)
+        return INTERIOR_CHORD_VARIANT;
+    return DEFAULT_VARIANT;
+}
+
+/**
+ * Enumerates all the voicings of a chord respecting the voice ranges, the order of the voices, the bass of the
+ * chord and the note occurrence rules.
+ * @param tonality the tonality of the chord
+ * @param degree the degree of the chord
+ * @param quality the quality of the chord
+ * @param state the state of the chord
+ * @param variant the variant of the chord (see chord_variants)
+ * @return the legal voicings of the chord, by increasing bass, tenor, alto and soprano
+ */
+vector<ChordVoicing> ChainModel::enumerate_voicings(const Tonality* tonality, const int degree, const int quality,
+                                                    const int state, const int variant) {
+    if (state == THIRD_INVERSION && quality < DOMINANT_SEVENTH_CHORD)
+        throw std::invalid_argument("The chord cannot be in third inversion");
+
+    /// the notes of the chord as a bit mask
+    const int chordNotes = get_chord_pitch_class_mask(tonality->get_degree_note(degree), quality);
+    const int bassNote = (tonality->get_degree_note(degree) + get_interval_from_root(quality, state)) % PERFECT_OCTAVE;
+    auto in_chord = [chordNotes](const int note) { return (chordNotes >> (note % PERFECT_OCTAVE) & 1) != 0; };
+
+    vector<ChordVoicing> result;
+    for (int b = BASS_MIN; b <= BASS_MAX; b++) {
+        if (b % PERFECT_OCTAVE != bassNote)
+            continue;
+        for (int t = std::max(b, TENOR_MIN); t <= TENOR_MAX; t++) {
+            if (!in_chord(t))
+                continue;
+            for (int a = std::max(t, ALTO_MIN); a <= ALTO_MAX; a++) {
+                if (!in_chord(a))
+                    continue;
+                for (int s = std::max(a, SOPRANO_MIN); s <= SOPRANO_MAX; s++) {
+                    if (!in_chord(s))
+                        continue;
+                    const ChordVoicing voicing = {b, t, a, s};
+                    if (respects_note_occurrences(tonality, degree, quality, state, variant, voicing))
+                        result.push_back(voicing);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * Checks the note occurrence rules of a chord (which notes must be present, doubled, etc.). This is the only definition
+ * of these rules: the voicing tables of the model are enumerated with it (see get_chord_voicing_table).
+ * @param tonality the tonality of the chord
+ * @param degree the degree of the chord
+ * @param quality the quality of the chord
+ * @param state the state of the chord
+ * @param variant the variant of the chord (see chord_variants)
+ * @param voicing the voicing of the chord
+ * @return true if the rules are respected, false otherwise
+ */
+bool ChainModel::respects_note_occurrences(const Tonality* tonality, const int degree, const int quality,
+                                           const int state, const int variant, const ChordVoicing& voicing) {
+    const int root   = tonality->get_degree_note(degree);
+    const int third  = (root + get_interval_from_root(quality, THIRD)) % PERFECT_OCTAVE;
+    const int fifth  = (root + get_interval_from_root(quality, FIFTH)) % PERFECT_OCTAVE;
+    const bool hasSeventh = quality >= DOMINANT_SEVENTH_CHORD;
+    const int seventh = hasSeventh ? (root + get_interval_from_root(quality, SEVENTH)) % PERFECT_OCTAVE : -1;
+
+    const int nRoots    = count_note(voicing, root % PERFECT_OCTAVE);
+    const int nThirds   = count_note(voicing, third);
+    const int nFifths   = count_note(voicing, fifth);
+    const int nSevenths = hasSeventh ? count_note(voicing, seventh) : 0;
+
+    switch (state) {
+        case FUNDAMENTAL_STATE: {
+            if (degree == SEVENTH_DEGREE && quality == DIMINISHED_CHORD)
+                return (count_values(voicing) != 4 || nThirds == 2) && nRoots >= 1 && nThirds >= 1 && nFifths >= 1;
+            if (degree == FLAT_TWO)
+                return nRoots == 1 && nThirds == 2 && nFifths >= 1;
+            if (degree == AUGMENTED_SIXTH || (degree == SIXTH_DEGREE && variant == AFTER_FIFTH_DEGREE_VARIANT))
+                return nRoots == 1 && nThirds == 2 && nFifths == 1;
+            if (nRoots < 1 || nThirds != 1 || nFifths > 1)
+                return false;
+            if (is_dominant(degree)) {
+                if (hasSeventh && (nSevenths != 1 || (count_notes(voicing) < 4) != (nRoots == 2)))
+                    return false;
+                return true;
+            }
+            if (degree == FIRST_DEGREE)
+                return (count_notes(voicing) < 3) == (nRoots == 3) && (!hasSeventh || nSevenths == 1);
+            return hasSeventh ? nSevenths == 1 : nFifths == 1;
+        }
+        case FIRST_INVERSION: {
+            if (!default_first_inversion_doubling(tonality, degree, quality)) {
+                if (is_dominant(degree) && quality == DIMINISHED_SEVENTH_CHORD &&
+                    !tonality->is_tonal_note(third)) {
+                    const int rootDim = (root + MINOR_THIRD) % PERFECT_OCTAVE;
+                    for (int k = 0; k < 4; k++)
+                        if (count_note(voicing, (rootDim + k * MINOR_THIRD) % PERFECT_OCTAVE) != 1)
+                            return false;
+                }
+                else if (nThirds != 2)
+                    return false;
+            }
+            /// interior chords double the third depending on the motion around them (see ChainModel::is_motion_dependent)
+            else if (variant == INTERIOR_CHORD_VARIANT) {
+                if (nThirds != 1 && nThirds != 2)
+                    return false;
+            }
+            else if (nRoots != 1)
+                return false;
+            if (quality != MINOR_NINTH_DOMINANT_CHORD && nRoots < 1)
+                return false;
+            return nThirds >= 1 && nFifths >= 1 && (!hasSeventh || nSevenths >= 1);
+        }
+        case SECOND_INVERSION: {
+            if (degree == SEVENTH_DEGREE && quality == DIMINISHED_CHORD)
+                return nRoots == 1 && nThirds == 2 && nFifths == 1;
+            return nRoots == 1 && nThirds == 1 && nFifths >= 1 && (!hasSeventh || nSevenths == 1);
+        }
+        case THIRD_INVERSION:
+            return nRoots == 1 && nThirds == 1 && nFifths >= 1 && nSevenths == 1;
+        default:
+            return true;
+    }
+}
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "../../headers/diatony/ChainSolver.hpp"
+
+/**
+ * Keeps only the best reached states of a chord, ties being broken in favour of the first state
+ * @param reached whether each state of the chord is reached. The states that are not kept are set to false.
+ * @param best the best cost of each state of the chord
+ * @param beamWidth the maximum number of states to keep
+ */
+static void prune_states(vector<bool>& reached, const vector<CostVector>& best, const int beamWidth) {
+    vector<int> states;
+    for (int s = 0; s < static_cast<int>(reached.size()); s++)
+        if (reached[s])
+            states.push_back(s);
+    if (static_cast<int>(states.size()) <= beamWidth)
+        return;
+    std::stable_sort(states.begin(), states.end(), [&best](const int a, const int b) {
+        return best[a] < best[b];
+    });
+    for (int k = beamWidth; k < static_cast<int>(states.size()); k++)
+        reached[states[k]] = false;
+}
+
+/**
+ * Finds an optimal voicing of the progression
+ * @param beamWidth the maximum number of states kept for each chord, 0 to keep all of them (exact search)
+ * @return true if a voicing was found, false otherwise (the progression has no solution if beamWidth is 0)
+ */
+bool ChainSolver::solve(const int beamWidth) {
+    const int size = model.get_size();
+    solved = false;
+    voicing.clear();
+    nTransitions = 0;
+    if (size == 0)
+        return false;
+
+    /// A state is a voicing of a chord together with the motion leading to it (whether the bass rose and the soprano
+    /// fell by step), which is only relevant for motion dependent chords. State j*2+m is voicing j with motion m.
+    vector<vector<bool>>        reached(size);
+    vector<vector<CostVector>>  best(size);
+    vector<vector<int>>         parent(size);
+    for (int i = 0; i < size; i++) {
+        const auto nStates = 2 * model.get_voicings(i).size();
+        reached[i].assign(nStates, false);
+        best[i].resize(nStates);
+        parent[i].assign(nStates, -1);
+    }
+    for (int j = 0; j < static_cast<int>(model.get_voicings(0).size()); j++) {
+        reached[0][2 * j] = true;
+        best[0][2 * j] = model.get_chord_cost(0, j);
+    }
+
+    for (int i = 0; i < size - 1; i++) {
+        /// beam search: only the best states of the chord are expanded
+        if (beamWidth > 0)
+            prune_states(reached[i], best[i], beamWidth);
+        const auto& currentVoicings = model.get_voicings(i);
+        const auto& nextVoicings = model.get_voicings(i + 1);
+        for (int state = 0; state < static_cast<int>(reached[i].size()); state++) {
+            if (!reached[i][state])
+                continue;
+            const ChordVoicing& current = currentVoicings[state / 2];
+            const bool approachedByContraryMotion = state % 2 == 1;
+            for (int k = 0; k < static_cast<int>(nextVoicings.size()); k++) {
+                const ChordVoicing& next = nextVoicings[k];
+                nTransitions++;
+                if (!model.is_legal_transition(i, current, next))
+                    continue;
+                const bool contraryMotion = ChainModel::stepwise_contrary_motion(current, next);
+                /// the third of a motion dependent chord is doubled iff it is surrounded by stepwise contrary motion
+                if (model.is_motion_dependent(i) &&
+                    model.count_thirds(i, current) != (approachedByContraryMotion && contraryMotion ? 2 : 1))
+                    continue;
+
+                const int nextState = 2 * k + (model.is_motion_dependent(i + 1) && contraryMotion ? 1 : 0);
+                const CostVector transition = ChainModel::transition_cost(current, next);
+                const CostVector& chord = model.get_chord_cost(i + 1, k);
+                CostVector cost;
+                for (int c = 0; c < N_COSTS; c++)
+                    cost[c] = best[i][state][c] + transition[c] + chord[c];
+                if (!reached[i + 1][nextState] || cost < best[i + 1][nextState]) {
+                    reached[i + 1][nextState] = true;
+                    best[i + 1][nextState] = cost;
+                    parent[i + 1][nextState] = state;
+                }
+            }
+        }
+    }
+
+    /// find the best final state and rebuild the voicing backwards
+    int state = -1;
+    for (int s = 0; s < static_cast<int>(reached[size - 1].size()); s++)
+        if (reached[size - 1][s] && (state == -1 || best[size - 1][s] < best[size - 1][state]))
+            state = s;
+    if (state == -1)
+        return false;
+
+    costs = best[size - 1][state];
+    voicing.assign(4 * size, 0);
+    for (int i = size - 1; i >= 0; i--) {
+        const ChordVoicing& chord = model.get_voicings(i)[state / 2];
+        for (int v = BASS; v <= SOPRANO; v++)
+            voicing[4 * i + v] = chord[v];
+        state = parent[i][state];
+    }
+    solved = true;
+    return true;
+}
+
+/**
+ * Returns the optimal voicing of a piece containing a single section, using the chain dynamic programming solver.
+ * @param params the parameters of the problem. It must contain exactly one section.
+ * @param voicing the vector in which the optimal voicing is written
+ * @param costs the vector in which the costs of the optimal voicing are written, in the order of the cost vector of
+ * FourVoiceTexture
+ * @param print whether to print the solution and the time taken
+ * @param beamWidth the maximum number of states kept for each chord, 0 for an exact search (see ChainSolver::solve)
+ * @return true if a solution was found, false if the problem has no solution (or if the beam search found none)
+ */
+bool solve_diatony_chain(const FourVoiceTextureParameters* params, vector<int>& voicing, vector<int>& costs,
+                         const bool print, const int beamWidth) {
+    if (params->get_numberOfSections() != 1)
+        throw std::invalid_argument("The chain solver only handles pieces with a single section, got " +
+            std::to_string(params->get_numberOfSections()) + " sections.");
+
+    const auto start = std::chrono::high_resolution_clock::now();     /// start time
+    const ChainModel model(params->get_sectionParameters(0));
+    ChainSolver solver(model);
+    const bool found = solver.solve(beamWidth);
+    const std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+
+    if (found) {
+        voicing = solver.get_voicing();
+        costs = solver.get_cost_values();
+    }
+    if (print) {
+        if (found)
+            std::cout << (beamWidth > 0 ? "Beam search voicing: {" : "Optimal voicing: {")
+                      << int_vector_to_string(voicing) << "}\nCost vector = {" << int_vector_to_string(costs) << "}"
+                      << std::endl;
+        else
+            std::cout << "No solutions" << std::endl;
+        std::cout << "time taken: " << duration.count() << " seconds and " << solver.get_number_of_transitions()
+                  << " transitions evaluated.\n" << std::endl;
+    }
+    return found;
+}
@@ -0,0 +1,205 @@
+#include <algorithm>
+
+#include "../../headers/diatony/ChordBrancher.hpp"
+#include "../../headers/diatony/ChainModel.hpp"
+
+namespace {
+    /**
+     * The choice of a chord brancher: the position of the chord and its candidate voicings, from the cheapest to the
+     * most expensive. Alternative k assigns the k-th candidate.
+     */
+    class ChordChoice : public Choice {
+    public:
+        int                     chord;          // the position of the chord
+        vector<ChordVoicing>    candidates;     // the candidate voicings of the chord
+
+        ChordChoice(const Brancher& b, const int chord, const vector<ChordVoicing>& candidates)
+            : Choice(b, std::max(1U, static_cast<unsigned int>(candidates.size()))), chord(chord),
+              candidates(candidates) {}
+
+        void archive(Archive& e) const override {
+            Choice::archive(e);
+            e << chord << static_cast<int>(candidates.size());
+            for (const auto& candidate : candidates)
+                for (const int note : candidate)
+                    e << note;
+        }
+    };
+
+    /**
+     * Brancher assigning a whole chord in each decision, trying its voicings in increasing order of incremental cost
+     */
+    class ChordBrancher : public Brancher {
+    protected:
+        ViewArray<Int::IntView>             x;          // the voicing of the whole piece
+        const FourVoiceTextureParameters*   params;     // the parameters of the piece (not owned)
+        mutable int                         last;       // all the chords after this one are assigned
+
+        /// Constructor for posting
+        ChordBrancher(Home home, ViewArray<Int::IntView>& x, const FourVoiceTextureParameters* params)
+            : Brancher(home), x(x), params(params), last(x.size() / 4 - 1) {}
+
+        /// Constructor for cloning
+        ChordBrancher(Space& home, ChordBrancher& b) : Brancher(home, b), params(b.params), last(b.last) {
+            x.update(home, b.x);
+        }
+
+        /**
+         * Returns whether all the notes of a chord are assigned
+         * @param chord the position of the chord
+         * @return true if the chord is assigned
+         */
+        bool assigned(const int chord) const {
+            for (int v = BASS; v <= SOPRANO; v++)
+                if (!x[chord * 4 + v].assigned())
+                    return false;
+            return true;
+        }
+
+        /**
+         * Returns the voicing of an assigned chord
+         * @param chord the position of the chord
+         * @return the notes of the chord
+         */
+        ChordVoicing voicing(const int chord) const {
+            return {x[chord * 4 + BASS].val(), x[chord * 4 + TENOR].val(), x[chord * 4 + ALTO].val(),
+                x[chord * 4 + SOPRANO].val()};
+        }
+
+        /**
+         * Returns the cost that a voicing of a chord adds to the cost vector, given the neighbours already assigned
+         * @param chord the position of the chord
+         * @param candidate the voicing of the chord
+         * @return the incremental cost vector
+         */
+        CostVector incremental_cost(const int chord, const ChordVoicing& candidate) const {
+            /// the quality and state of the chord are given by the first section containing it
+            int section = 0;
+            while (section < params->get_numberOfSections() - 1 && params->get_sectionEnd(section) < chord)
+                section++;
+            const TonalProgressionParameters* sectionParams = params->get_sectionParameters(section);
+            const int position = chord - sectionParams->get_start();
+            CostVector cost = ChainModel::chord_cost(sectionParams->get_chordQualities()[position],
+                sectionParams->get_chordStates()[position], candidate);
+
+            CostVector transition = {0, 0, 0, 0, 0};
+            if (chord > 0 && assigned(chord - 1)) {
+                transition = ChainModel::transition_cost(voicing(chord - 1), candidate);
+                for (int c = 0; c < N_COSTS; c++)
+                    cost[c] += transition[c];
+            }
+            if (chord < x.size() / 4 - 1 && assigned(chord + 1)) {
+                transition = ChainModel::transition_cost(candidate, voicing(chord + 1));
+                for (int c = 0; c < N_COSTS; c++)
+                    cost[c] += transition[c];
+            }
+            return cost;
+        }
+
+    public:
+        /**
+         * Posts the brancher
+         * @param home the space
+         * @param x the voicing of the whole piece
+         * @param params the parameters of the piece
+         */
+        static void post(Home home, ViewArray<Int::IntView>& x, const FourVoiceTextureParameters* params) {
+            (void) new (home) ChordBrancher(home, x, params);
+        }
+
+        bool status(const Space&) const override {
+            for (; last >= 0; last--)
+                if (!assigned(last))
+                    return true;
+            return false;
+        }
+
+        const Choice* choice(Space&) override {
+            /// status() moved last to the last chord that is not assigned
+            const int chord = last;
+            vector<ChordVoicing> candidates;
+            for (Int::ViewValues<Int::IntView> b(x[chord * 4 + BASS]); b(); ++b)
+                for (Int::ViewValues<Int::IntView> t(x[chord * 4 + TENOR]); t(); ++t)
+                    for (Int::ViewValues<Int::IntView> a(x[chord * 4 + ALTO]); a(); ++a)
+                        for (Int::ViewValues<Int::IntView> s(x[chord * 4 + SOPRANO]); s(); ++s)
+                            if (b.val() <= t.val() && t.val() <= a.val() && a.val() <= s.val())
+                                candidates.push_back({b.val(), t.val(), a.val(), s.val()});
+
+            vector<CostVector> costs;
+            costs.reserve(candidates.size());
+            for (const auto& candidate : candidates)
+                costs.push_back(incremental_cost(chord, candidate));
+            vector<int> order(candidates.size());
+            for (int i = 0; i < static_cast<int>(order.size()); i++)
+                order[i] = i;
+            std::stable_sort(order.begin(), order.end(), [&costs](const int i, const int j) {
+                return costs[i] < costs[j];
+            });
+            vector<ChordVoicing> sorted;
+            sorted.reserve(candidates.size());
+            for (const int i : order)
+                sorted.push_back(candidates[i]);
+            return new ChordChoice(*this, chord, sorted);
+        }
+
+        const Choice* choice(const Space&, Archive& e) override {
+            int chord, nCandidates;
+            e >> chord >> nCandidates;
+            vector<ChordVoicing> candidates(nCandidates);
+            for (auto& candidate : candidates)
+                for (int& note : candidate)
+                    e >> note;
+            return new ChordChoice(*this, chord, candidates);
+        }
+
+        ExecStatus commit(Space& home, const Choice& c, const unsigned int a) override {
+            const auto& choice = static_cast<const ChordChoice&>(c);
+            /// no voicing is compatible with the order of the voices
+            if (choice.candidates.empty())
+                return ES_FAILED;
+            for (int v = BASS; v <= SOPRANO; v++)
+                GECODE_ME_CHECK(x[choice.chord * 4 + v].eq(home, choice.candidates[a][v]));
+            return ES_OK;
+        }
+
+        void print(const Space&, const Choice& c, const unsigned int a, std::ostream& o) const override {
+            const auto& choice = static_cast<const ChordChoice&>(c);
+            o << "chord " << choice.chord << " = ";
+            if (choice.candidates.empty())
+                o << "none";
+            else
+                o << "{" << int_vector_to_string(vector<int>(choice.candidates[a].begin(), choice.candidates[a].end()))
+                  << "}";
+        }
+
+        Brancher* copy(Space& home) override {
+            return new (home) ChordBrancher(home, *this);
+        }
+
+        size_t dispose(Space& home) override {
+            (void) Brancher::dispose(home);
+            return sizeof(*this);
+        }
+    };
+}
+
+/**
+ * Posts a brancher that assigns a whole chord in each decision. Chords are selected from the last one to the first one,
+ * like the RIGHT_TO_LEFT heuristic. The candidate voicings of the selected chord (the combinations of the values left in
+ * the domains of its voices, in increasing order) are tried in increasing lexicographical order of the cost they add
+ * to the cost vector: the costs of the chord itself and the costs of the transitions with its neighbours that are
+ * already assigned. The first solutions are then close to optimal, which speeds up branch and bound.
+ * @param home the instance of the problem
+ * @param fullVoicing the voicing of the whole piece [bass0, tenor0, alto0, soprano0, bass1, ...]
+ * @param params the parameters of the piece, used to get the quality and state of each chord. They must outlive the
+ * space.
+ */
+void chord_branch(Home home, const IntVarArray& fullVoicing, const FourVoiceTextureParameters* params) {
+    if (home.failed())
+        return;
+    IntVarArgs notes;
+    for (int i = 0; i < fullVoicing.size(); i++)
+        notes << fullVoicing[i];
+    ViewArray<Int::IntView> x(home, notes);
+    ChordBrancher::post(home, x, params);
+}
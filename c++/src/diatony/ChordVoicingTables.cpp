@@ -0,0 +1,48 @@
+#include <mutex>
+
+#include "../../headers/diatony/ChordVoicingTables.hpp"
+
+/**
+ * Returns the table of all the legal voicings of a chord, that is the voicings respecting the voice ranges, the order
+ * of the voices, the bass of the chord and its note occurrence rules (see ChainModel::enumerate_voicings). Each tuple
+ * also contains the values of the cost-related variables of the chord (see chord_table_columns), so that a single
+ * extensional constraint replaces the domain, count and nvalues constraints of the chord.
+ * The tables are built once per process on first use and shared by all the spaces. This function is thread-safe.
+ * @param tonality the tonality of the chord
+ * @param degree the degree of the chord
+ * @param quality the quality of the chord
+ * @param state the state of the chord
+ * @param variant the variant of the chord (see chord_variants)
+ * @return the table of the legal voicings of the chord
+ */
+const TupleSet& get_chord_voicing_table(const Tonality* tonality, const int degree, const int quality, const int state,
+                                        const int variant) {
+    /// the tonality is identified by its tonic and mode rather than its address, as Tonality objects can be deleted
+    typedef std::array<int, 6> TableKey;
+    static std::mutex lock;
+    static map<TableKey, TupleSet> tables;
+
+    const TableKey key = {tonality->get_tonic(), tonality->get_mode(), degree, quality, state, variant};
+    std::lock_guard<std::mutex> guard(lock);
+    const auto it = tables.find(key);
+    if (it != tables.end())
+        return it->second;
+
+    TupleSet table(CHORD_TABLE_ARITY);
+    for (const ChordVoicing& voicing : ChainModel::enumerate_voicings(tonality, degree, quality, state, variant)) {
+        int notes = 0;
+        int nValues = 1;
+        for (int v = BASS; v <= SOPRANO; v++) {
+            notes |= 1 << (voicing[v] % PERFECT_OCTAVE);
+            if (v > BASS && voicing[v] != voicing[v - 1])
+                nValues++;
+        }
+        int nNotes = 0;
+        for (; notes != 0; notes &= notes - 1)
+            nNotes++;
+        const int nDiminishedValues = quality == DIMINISHED_CHORD && state == FUNDAMENTAL_STATE ? nValues : 0;
+        table.add(IntArgs({voicing[BASS], voicing[TENOR], voicing[ALTO], voicing[SOPRANO], nNotes, nDiminishedValues}));
+    }
+    table.finalize();
+    return tables.emplace(key, table).first->second;
+}
@@ -0,0 +1,79 @@
+#include "../../headers/diatony/ConstraintRegistry.hpp"
+
+const vector<string> rule_family_names = {
+    "Parallel intervals",           // 0
+    "Tritone resolution",           // 1
+    "Interrupted cadence",          // 2
+    "Italian augmented sixth",      // 3
+    "Fifth degree appogiatura",     // 4
+    "Species seventh",              // 5
+    "Contrary motion",              // 6
+    "Chord voicing",                // 7
+    "Double third",                 // 8
+    "Chromatic modulation",         // 9
+};
+
+/**
+ * Constructor
+ * @param home the space in which the rules are posted
+ */
+ConstraintRegistry::ConstraintRegistry(Home home) : home(home), nRules(N_RULE_FAMILIES, 0),
+    nDuplicates(N_RULE_FAMILIES, 0), nPropagators(N_RULE_FAMILIES, 0U), literals(home) {}
+
+/**
+ * Posts a rule and adds the propagators it created to its family
+ * @param family the family of the rule (see rule_families)
+ * @param rule posts the constraints of the rule
+ */
+void ConstraintRegistry::post_rule(const int family, const std::function<void()>& rule) {
+    if (family < 0 || family >= N_RULE_FAMILIES)
+        throw std::invalid_argument("ConstraintRegistry: unknown rule family: " + std::to_string(family));
+    const Space& space = home;
+    const unsigned int before = space.propagators();
+    rule();
+    nPropagators[family] += space.propagators() - before;
+    nRules[family]++;
+}
+
+/**
+ * Posts a rule on a pair of voices unless a rule with the same family, position and voices has already been posted
+ * @param family the family of the rule (see rule_families)
+ * @param position the absolute position of the rule in the piece
+ * @param voice1 the first voice constrained by the rule, or ALL_VOICES
+ * @param voice2 the second voice constrained by the rule, or ALL_VOICES
+ * @param rule posts the constraints of the rule
+ * @return true if the rule was posted, false if it was a duplicate
+ */
+bool ConstraintRegistry::post(const int family, const int position, const int voice1, const int voice2,
+    const std::function<void()>& rule) {
+    if (!posted.insert(RuleKey(family, position, voice1, voice2)).second) {
+        nDuplicates[family]++;
+        return false;
+    }
+    post_rule(family, rule);
+    return true;
+}
+
+/**
+ * Posts a rule without checking for duplicates, only keeping the statistics of its family
+ * @param family the family of the rule (see rule_families)
+ * @param rule posts the constraints of the rule
+ */
+void ConstraintRegistry::count(const int family, const std::function<void()>& rule) {
+    post_rule(family, rule);
+}
+
+/**
+ * to_string method
+ * @return a line per family with the number of rules posted, rejected and the propagators created
+ */
+string ConstraintRegistry::to_string() const {
+    string message = "Rules posted during construction (family : rules, duplicates rejected, propagators):\n";
+    for (int family = 0; family < N_RULE_FAMILIES; family++) {
+        if (nRules[family] == 0 && nDuplicates[family] == 0)
+            continue;
+        message += rule_family_names[family] + " : " + std::to_string(nRules[family]) + ", " +
+            std::to_string(nDuplicates[family]) + ", " + std::to_string(nPropagators[family]) + "\n";
+    }
+    return message;
+}
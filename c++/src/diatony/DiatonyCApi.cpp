@@ -0,0 +1,281 @@
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "../../headers/diatony/DiatonyCApi.h"
+#include "../../headers/diatony/SolutionCache.hpp"
+#include "../../headers/diatony/SolveDiatony.hpp"
+
+/**
+ * A solver handle. The caller only sees an opaque pointer to it.
+ */
+struct diatony_solver {
+    SolutionCache               cache;          // the solutions of the problems solved recently
+    unsigned int                nWorkers;       // the number of threads searching each problem
+    std::mutex                  lock;           // protects the running searches
+    std::set<CancellableStop*>  running;        // the stop objects of the running searches
+
+    diatony_solver(const unsigned int nWorkers, const size_t cacheSize) : cache(cacheSize), nWorkers(nWorkers) {}
+};
+
+namespace {
+    /// the message of the last error on each thread, returned by diatony_last_error
+    thread_local string lastError;
+
+    /**
+     * The parameters of a problem given through the C interface. They are deleted with the object.
+     */
+    class Problem {
+    protected:
+        vector<TonalProgressionParameters*>     sections;
+        vector<ModulationParameters*>           modulations;
+        FourVoiceTextureParameters*             params = nullptr;
+        string                                  key;            // the problem encoded as ints, for the cache
+
+        void append(const int value) { key.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+    public:
+        /**
+         * Constructor. The arguments are those of diatony_solve_sections.
+         * @throws std::invalid_argument if the arrays do not describe a piece
+         */
+        Problem(const int nSections, const int* tonics, const int* modes, const int* sizes, const int* modulationTypes,
+                const int* modulationStarts, const int* modulationEnds, const int* degrees, const int* qualities,
+                const int* states) {
+            if (nSections <= 0)
+                throw std::invalid_argument("The piece must contain at least one section");
+            if (tonics == nullptr || modes == nullptr || sizes == nullptr || degrees == nullptr ||
+                qualities == nullptr || states == nullptr || (nSections > 1 && (modulationTypes == nullptr ||
+                modulationStarts == nullptr || modulationEnds == nullptr)))
+                throw std::invalid_argument("An array of the problem is NULL");
+            try {
+                int start = 0;      // the position of the first chord of the section in the piece
+                int offset = 0;     // the position of the first chord of the section in the chord arrays
+                for (int s = 0; s < nSections; s++) {
+                    if (sizes[s] <= 0)
+                        throw std::invalid_argument("Section " + std::to_string(s) + " has no chord");
+                    const Tonality* tonality = Tonality::get_tonality(tonics[s], modes[s]);
+                    const vector<int> sectionDegrees(degrees + offset, degrees + offset + sizes[s]);
+                    const vector<int> sectionQualities(qualities + offset, qualities + offset + sizes[s]);
+                    const vector<int> sectionStates(states + offset, states + offset + sizes[s]);
+                    sections.push_back(new TonalProgressionParameters(s, sizes[s], start, start + sizes[s] - 1,
+                        tonality, sectionDegrees, sectionQualities, sectionStates));
+                    append(tonics[s]);
+                    append(modes[s]);
+                    append(start);
+                    for (int i = offset; i < offset + sizes[s]; i++) {
+                        append(degrees[i]);
+                        append(qualities[i]);
+                        append(states[i]);
+                    }
+                    offset += sizes[s];
+                    start += sizes[s];
+                    if (s < nSections - 1 && modulationTypes[s] == PIVOT_CHORD_MODULATION)
+                        start--;    /// the pivot chord is the first chord of the next section
+                }
+                for (int m = 0; m < nSections - 1; m++) {
+                    modulations.push_back(new ModulationParameters(modulationTypes[m], modulationStarts[m],
+                        modulationEnds[m], sections[m], sections[m + 1]));
+                    append(modulationTypes[m]);
+                    append(modulationStarts[m]);
+                    append(modulationEnds[m]);
+                }
+                params = new FourVoiceTextureParameters(start, nSections, sections, modulations);
+            }
+            catch (...) {
+                release();
+                throw;
+            }
+        }
+
+        Problem(const Problem&) = delete;
+
+        Problem& operator=(const Problem&) = delete;
+
+        ~Problem() { release(); }
+
+        void release() {
+            delete params;
+            for (auto modulation : modulations)
+                delete modulation;
+            for (auto section : sections)
+                delete section;
+            params = nullptr;
+            modulations.clear();
+            sections.clear();
+        }
+
+        FourVoiceTextureParameters* get_parameters() const { return params; }
+
+        const string& get_key() const { return key; }
+    };
+
+    /**
+     * Registers the stop object of a search in its handle while the search is running, so that it can be cancelled
+     */
+    class RunningSearch {
+    protected:
+        diatony_solver*     solver;
+        CancellableStop*    stop;
+    public:
+        RunningSearch(diatony_solver* solver, CancellableStop* stop) : solver(solver), stop(stop) {
+            std::lock_guard<std::mutex> guard(solver->lock);
+            solver->running.insert(stop);
+        }
+
+        RunningSearch(const RunningSearch&) = delete;
+
+        RunningSearch& operator=(const RunningSearch&) = delete;
+
+        ~RunningSearch() {
+            std::lock_guard<std::mutex> guard(solver->lock);
+            solver->running.erase(stop);
+        }
+    };
+
+    /**
+     * Searches for the best solution of a problem with the settings of a handle
+     * @param solver the handle
+     * @param params the parameters of the problem
+     * @param stop the stop object of the search, with its time limit
+     * @param timeLimit the time limit of the search in milliseconds
+     * @return the best solution found
+     */
+    DiatonySolution search(const diatony_solver* solver, FourVoiceTextureParameters* params, CancellableStop* stop,
+                           const double timeLimit) {
+        const int nChords = params->get_totalNumberOfChords();
+        Options options;
+        options.stop = stop;
+        options.nogoods_limit = nChords * 4 * 4;
+        if (solver->nWorkers == 1) {
+            /// same search as solve_diatony without options (and its default cutoff)
+            options.threads = 1;
+            return solve_diatony(DiatonySnapshot(params), &options, false, timeLimit);
+        }
+
+        const FourVoiceTexture* sol = solve_diatony_portfolio(params, &options, false, solver->nWorkers);
+        if (sol == nullptr)
+            return DiatonySolution();
+        DiatonySolution solution(*sol, Search::Statistics());
+        delete sol;
+        return solution;
+    }
+
+    /**
+     * Solves a problem and writes its solution into the buffers of the caller (see diatony_solve_sections)
+     * @return the status of the search
+     */
+    int solve(diatony_solver* solver, const Problem& problem, const double timeLimit, int* voicing,
+              const int voicingCapacity, int* costs, const int costsCapacity, int* nCosts) {
+        const int nChords = problem.get_parameters()->get_totalNumberOfChords();
+        if (voicing == nullptr || voicingCapacity < 4 * nChords) {
+            lastError = "The voicing buffer needs " + std::to_string(4 * nChords) + " values";
+            return DIATONY_BUFFER_TOO_SMALL;
+        }
+        if (timeLimit <= 0)
+            throw std::invalid_argument("The time limit must be positive");
+
+        vector<int> notes, values;
+        bool cancelled = false;
+        if (!solver->cache.find(problem.get_key(), timeLimit, notes, values)) {
+            CancellableStop stop(timeLimit);
+            DiatonySolution solution;
+            {
+                const RunningSearch running(solver, &stop);
+                solution = search(solver, problem.get_parameters(), &stop, timeLimit);
+            }
+            /// the solution of a cancelled search is not kept, as it would be returned instead of a better one later
+            cancelled = stop.is_cancelled();
+            if (!solution.found())
+                return cancelled ? DIATONY_CANCELLED : DIATONY_NO_SOLUTION;
+            notes = solution.get_voicing();
+            values = solution.get_costs();
+            if (!cancelled)
+                solver->cache.insert(problem.get_key(), timeLimit, notes, values);
+        }
+
+        if (nCosts != nullptr)
+            *nCosts = static_cast<int>(values.size());
+        if (!values.empty() && (costs == nullptr || costsCapacity < static_cast<int>(values.size()))) {
+            lastError = "The costs buffer needs " + std::to_string(values.size()) + " values";
+            return DIATONY_BUFFER_TOO_SMALL;
+        }
+        std::copy(notes.begin(), notes.end(), voicing);
+        std::copy(values.begin(), values.end(), costs);
+        return cancelled ? DIATONY_CANCELLED : DIATONY_SOLVED;
+    }
+}
+
+int diatony_api_version(void) {
+    return DIATONY_API_VERSION;
+}
+
+diatony_solver* diatony_solver_create(const unsigned int n_workers, const unsigned int cache_size) {
+    try {
+        const unsigned int nWorkers = n_workers != 0 ? n_workers : std::max(1U, std::thread::hardware_concurrency());
+        return new diatony_solver(nWorkers, cache_size);
+    }
+    catch (const std::exception& e) {
+        lastError = e.what();
+        return nullptr;
+    }
+}
+
+void diatony_solver_destroy(diatony_solver* solver) {
+    delete solver;
+}
+
+void diatony_solver_cancel(diatony_solver* solver) {
+    if (solver == nullptr)
+        return;
+    std::lock_guard<std::mutex> guard(solver->lock);
+    for (auto stop : solver->running)
+        stop->cancel();
+}
+
+int diatony_solve(diatony_solver* solver, const int tonic, const int mode, const int n_chords, const int* degrees,
+                  const int* qualities, const int* states, const double time_limit_ms, int* voicing, int* costs,
+                  const int costs_capacity, int* n_costs) {
+    return diatony_solve_sections(solver, 1, &tonic, &mode, &n_chords, nullptr, nullptr, nullptr, degrees, qualities,
+        states, time_limit_ms, voicing, 4 * n_chords, costs, costs_capacity, n_costs);
+}
+
+int diatony_solve_sections(diatony_solver* solver, const int n_sections, const int* tonics, const int* modes,
+                           const int* sizes, const int* modulation_types, const int* modulation_starts,
+                           const int* modulation_ends, const int* degrees, const int* qualities, const int* states,
+                           const double time_limit_ms, int* voicing, const int voicing_capacity, int* costs,
+                           const int costs_capacity, int* n_costs) {
+    if (n_costs != nullptr)
+        *n_costs = 0;
+    if (solver == nullptr) {
+        lastError = "The solver handle is NULL";
+        return DIATONY_INVALID;
+    }
+    try {
+        const Problem problem(n_sections, tonics, modes, sizes, modulation_types, modulation_starts, modulation_ends,
+            degrees, qualities, states);
+        return solve(solver, problem, time_limit_ms, voicing, voicing_capacity, costs, costs_capacity, n_costs);
+    }
+    catch (const std::invalid_argument& e) {
+        lastError = e.what();
+        return DIATONY_INVALID;
+    }
+    catch (const std::exception& e) {
+        lastError = e.what();
+        return DIATONY_ERROR;
+    }
+    catch (...) {
+        lastError = "Unknown error";
+        return DIATONY_ERROR;
+    }
+}
+
+size_t diatony_last_error(char* buffer, const size_t capacity) {
+    if (buffer != nullptr && capacity > 0) {
+        const size_t length = std::min(capacity - 1, lastError.size());
+        std::memcpy(buffer, lastError.data(), length);
+        buffer[length] = '\0';
+    }
+    return lastError.size();
+}
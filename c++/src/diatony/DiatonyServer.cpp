@@ -0,0 +1,513 @@
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../../headers/diatony/DiatonyServer.hpp"
+#include "../../headers/diatony/SolveDiatony.hpp"
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+#ifdef MSG_NOSIGNAL
+    constexpr int SEND_FLAGS = MSG_NOSIGNAL;   // a client that disconnected must not kill the server
+#else
+    constexpr int SEND_FLAGS = 0;              // SO_NOSIGPIPE is set on the connections instead
+#endif
+
+    /**
+     * Appends a 32-bit little-endian integer to a buffer
+     * @param buffer the buffer
+     * @param value the integer
+     */
+    void put_int(string& buffer, const int value) {
+        const auto bits = static_cast<uint32_t>(value);
+        for (int b = 0; b < 4; b++)
+            buffer.push_back(static_cast<char>((bits >> (8 * b)) & 0xFF));
+    }
+
+    /**
+     * Reads a 32-bit little-endian integer from a buffer
+     * @param buffer the buffer
+     * @param offset the position of the integer in the buffer
+     * @return the integer
+     */
+    int get_int(const string& buffer, const size_t offset) {
+        uint32_t bits = 0;
+        for (int b = 0; b < 4; b++)
+            bits |= static_cast<uint32_t>(static_cast<unsigned char>(buffer[offset + b])) << (8 * b);
+        return static_cast<int32_t>(bits);
+    }
+
+    /**
+     * Reads exactly n bytes from a socket
+     * @return false if the socket was closed or an error occurred
+     */
+    bool read_all(const int fd, char* data, size_t n) {
+        while (n > 0) {
+            const ssize_t r = ::recv(fd, data, n, 0);
+            if (r < 0 && errno == EINTR)
+                continue;
+            if (r <= 0)
+                return false;
+            data += r;
+            n -= static_cast<size_t>(r);
+        }
+        return true;
+    }
+
+    /**
+     * Writes exactly n bytes to a socket
+     * @return false if the socket was closed or an error occurred
+     */
+    bool write_all(const int fd, const char* data, size_t n) {
+        while (n > 0) {
+            const ssize_t w = ::send(fd, data, n, SEND_FLAGS);
+            if (w < 0 && errno == EINTR)
+                continue;
+            if (w <= 0)
+                return false;
+            data += w;
+            n -= static_cast<size_t>(w);
+        }
+        return true;
+    }
+
+    /**
+     * The parameters of a problem decoded from a request (see server_frame_types). They are deleted with the object.
+     */
+    class DecodedProblem {
+    protected:
+        vector<TonalProgressionParameters*>     sections;
+        vector<ModulationParameters*>           modulations;
+        FourVoiceTextureParameters*             params = nullptr;
+        const string&                           frame;
+        size_t                                  offset = 0;
+
+        int next() {
+            if (offset + 4 > frame.size())
+                throw std::invalid_argument("The request is truncated");
+            const int value = get_int(frame, offset);
+            offset += 4;
+            return value;
+        }
+
+    public:
+        /**
+         * Constructor
+         * @param problem the problem, as encoded in its request (after the time limit)
+         * @throws std::invalid_argument if the request is malformed
+         */
+        explicit DecodedProblem(const string& problem) : frame(problem) {
+            try {
+                const int nChords = next();
+                const int nSections = next();
+                for (int s = 0; s < nSections; s++) {
+                    const int tonic = next();
+                    const Tonality* tonality = Tonality::get_tonality(tonic, next());
+                    const int start = next();
+                    const int size = next();
+                    vector<int> degrees, qualities, states;
+                    for (int i = 0; i < size; i++) {
+                        degrees.push_back(next());
+                        qualities.push_back(next());
+                        states.push_back(next());
+                    }
+                    sections.push_back(new TonalProgressionParameters(s, size, start, start + size - 1, tonality,
+                        degrees, qualities, states));
+                }
+                for (int m = 0; m < nSections - 1; m++) {
+                    const int type = next();
+                    const int start = next();
+                    modulations.push_back(new ModulationParameters(type, start, next(), sections[m], sections[m + 1]));
+                }
+                if (offset != frame.size())
+                    throw std::invalid_argument("The request has " + std::to_string(frame.size() - offset) +
+                        " bytes after the problem");
+                params = new FourVoiceTextureParameters(nChords, nSections, sections, modulations);
+            }
+            catch (...) {
+                release();
+                throw;
+            }
+        }
+
+        DecodedProblem(const DecodedProblem&) = delete;
+
+        DecodedProblem& operator=(const DecodedProblem&) = delete;
+
+        ~DecodedProblem() { release(); }
+
+        void release() {
+            delete params;
+            for (auto modulation : modulations)
+                delete modulation;
+            for (auto section : sections)
+                delete section;
+            params = nullptr;
+            modulations.clear();
+            sections.clear();
+        }
+
+        FourVoiceTextureParameters* get_parameters() const { return params; }
+    };
+}
+
+/**
+ * A connection with a client. The socket is closed when the client disconnects, and the responses to its pending
+ * requests are then dropped.
+ */
+struct DiatonyServer::Connection {
+    int                 fd;
+    std::mutex          writeLock;          // serializes the responses, and protects the socket from being closed
+    bool                open = true;        // whether the socket is still open (protected by writeLock)
+
+    explicit Connection(const int fd) : fd(fd) {}
+};
+
+/**
+ * A solve request received from a client
+ */
+struct DiatonyServer::Request {
+    std::shared_ptr<Connection>     connection;
+    int                             id;
+    double                          timeLimit;      // in milliseconds
+    string                          problem;        // the problem, as encoded in the request
+    Clock::time_point               deadline;       // the reception time plus the time limit
+    CancellableStop                 stop;           // stops the search when the request is cancelled or expires
+
+    Request(std::shared_ptr<Connection> connection, const int id, const double timeLimit, string problem) :
+        connection(std::move(connection)), id(id), timeLimit(timeLimit), problem(std::move(problem)),
+        deadline(Clock::now() + std::chrono::microseconds(static_cast<long long>(timeLimit * 1000))),
+        stop(timeLimit) {}
+
+    double remaining_ms() const {
+        return std::chrono::duration<double, std::milli>(deadline - Clock::now()).count();
+    }
+};
+
+/**
+ * Constructor
+ * @param socketPath the path of the Unix domain socket. An existing file at this path is replaced.
+ * @param nWorkers the number of worker threads. If it is 0, one worker per hardware thread is used.
+ * @param cacheSize the maximum number of solutions kept
+ */
+DiatonyServer::DiatonyServer(string socketPath, const unsigned int nWorkers, const size_t cacheSize) :
+    socketPath(std::move(socketPath)),
+    nWorkers(nWorkers != 0 ? nWorkers : std::max(1U, std::thread::hardware_concurrency())),
+    listenFd(-1), wakeFd(-1), running(false), cache(cacheSize) {}
+
+DiatonyServer::~DiatonyServer() {
+    shutdown();
+}
+
+/**
+ * Listens on the socket and serves the clients until shutdown is called
+ * @throws std::runtime_error if the socket cannot be created
+ */
+void DiatonyServer::run() {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+        throw std::runtime_error("The socket path is too long: " + socketPath);
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        throw std::runtime_error(string("Could not create the socket: ") + std::strerror(errno));
+    ::unlink(socketPath.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(fd, SOMAXCONN) < 0) {
+        const string error = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("Could not listen on " + socketPath + ": " + error);
+    }
+    /// shutting down a listening socket does not wake accept on every system (e.g. macOS), so the accept loop waits
+    /// on a pipe as well, written by shutdown
+    int wake[2];
+    if (::pipe(wake) < 0) {
+        const string error = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("Could not create the wake-up pipe: " + error);
+    }
+    listenFd = fd;
+    wakeFd = wake[1];
+    running = true;
+
+    vector<std::thread> workers;
+    for (unsigned int w = 0; w < nWorkers; w++)
+        workers.emplace_back(&DiatonyServer::work, this);
+
+    while (running) {
+        pollfd events[2] = {{fd, POLLIN, 0}, {wake[0], POLLIN, 0}};
+        if (::poll(events, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (events[1].revents != 0)
+            break; /// shutdown was called
+        if ((events[0].revents & POLLIN) == 0)
+            break; /// the socket was closed or failed
+        const int client = ::accept(fd, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED || errno == EAGAIN || errno == EWOULDBLOCK)
+                continue;
+            break;
+        }
+#ifdef SO_NOSIGPIPE
+        const int noSigPipe = 1;
+        ::setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+        auto connection = std::make_shared<Connection>(client);
+        {
+            std::lock_guard<std::mutex> guard(connectionsLock);
+            connections.insert(connection);
+        }
+        std::thread(&DiatonyServer::serve, this, connection).detach();
+    }
+
+    shutdown();
+    for (auto& worker : workers)
+        worker.join();
+    cancel_queued();
+    /// unblock the connections that are still reading, and wait for them to close
+    std::unique_lock<std::mutex> lock(connectionsLock);
+    for (const auto& connection : connections) {
+        std::lock_guard<std::mutex> guard(connection->writeLock);
+        if (connection->open)
+            ::shutdown(connection->fd, SHUT_RDWR);
+    }
+    connectionsChanged.wait(lock, [this] { return connections.empty(); });
+    listenFd = -1;
+    wakeFd = -1;
+    ::close(fd);
+    ::close(wake[0]);
+    ::close(wake[1]);
+    ::unlink(socketPath.c_str());
+}
+
+/**
+ * Stops the server: no new client is accepted, the pending requests are cancelled and run returns once the
+ * connections are closed. This function is thread-safe, but it must not be called from a signal handler.
+ */
+void DiatonyServer::shutdown() {
+    running = false;
+    const int fd = wakeFd;
+    if (fd >= 0) {
+        const char byte = 0;
+        (void) ::write(fd, &byte, 1);
+    }
+    {
+        std::lock_guard<std::mutex> guard(requestsLock);
+        for (auto& request : requests)
+            request.second->stop.cancel();
+    }
+    {
+        /// taking the lock ensures that no worker misses the notification between its check and its wait
+        std::lock_guard<std::mutex> guard(queueLock);
+    }
+    queueChanged.notify_all();
+}
+
+/**
+ * Reads the frames of a connection until the client disconnects or the server shuts down
+ * @param connection the connection
+ */
+void DiatonyServer::serve(const std::shared_ptr<Connection>& connection) {
+    string header(4, '\0');
+    string frame;
+    while (running && read_all(connection->fd, &header[0], 4)) {
+        const int length = get_int(header, 0);
+        if (length < 4 || length > MAX_SERVER_FRAME_SIZE)
+            break;
+        frame.resize(length);
+        if (!read_all(connection->fd, &frame[0], length))
+            break;
+
+        const int type = get_int(frame, 0);
+        if (type == SOLVE_REQUEST && length < 12) {
+            const Request request(connection, length >= 8 ? get_int(frame, 4) : -1, 0, "");
+            respond(request, RESPONSE_INVALID, {}, {}, "The request is truncated");
+        }
+        else if (type == SOLVE_REQUEST) {
+            const int timeLimit = get_int(frame, 8);
+            auto request = std::make_shared<Request>(connection, get_int(frame, 4),
+                timeLimit >= 0 ? timeLimit : DEFAULT_TIME_LIMIT, frame.substr(12));
+            bool duplicate;
+            {
+                std::lock_guard<std::mutex> guard(requestsLock);
+                duplicate = !requests.emplace(std::make_pair(connection.get(), request->id), request).second;
+            }
+            if (duplicate) {
+                respond(*request, RESPONSE_INVALID, {}, {},
+                    "Request " + std::to_string(request->id) + " is already pending");
+                continue;
+            }
+            bool queued;
+            {
+                /// the queue is not read anymore once the server is shut down (see cancel_queued)
+                std::lock_guard<std::mutex> guard(queueLock);
+                queued = running;
+                if (queued)
+                    queue.push_back(request);
+            }
+            if (queued)
+                queueChanged.notify_one();
+            else
+                finish(*request, RESPONSE_CANCELLED);
+        }
+        else if (type == CANCEL_REQUEST && length >= 8) {
+            std::lock_guard<std::mutex> guard(requestsLock);
+            const auto request = requests.find(std::make_pair(connection.get(), get_int(frame, 4)));
+            if (request != requests.end())
+                request->second->stop.cancel();
+        }
+        /// other frames are ignored
+    }
+
+    /// the client is gone, its pending requests are not needed anymore
+    {
+        std::lock_guard<std::mutex> guard(requestsLock);
+        for (auto& request : requests)
+            if (request.first.first == connection.get())
+                request.second->stop.cancel();
+    }
+    {
+        std::lock_guard<std::mutex> guard(connection->writeLock);
+        connection->open = false;
+        ::close(connection->fd);
+    }
+    std::lock_guard<std::mutex> guard(connectionsLock);
+    connections.erase(connection);
+    connectionsChanged.notify_all();
+}
+
+/**
+ * Takes requests from the queue and solves them until the server shuts down
+ */
+void DiatonyServer::work() {
+    while (true) {
+        std::shared_ptr<Request> request;
+        {
+            std::unique_lock<std::mutex> lock(queueLock);
+            queueChanged.wait(lock, [this] { return !running || !queue.empty(); });
+            if (!running)
+                return;
+            request = queue.front();
+            queue.pop_front();
+        }
+        solve(*request);
+    }
+}
+
+/**
+ * Answers the requests left in the queue as cancelled
+ */
+void DiatonyServer::cancel_queued() {
+    std::deque<std::shared_ptr<Request>> cancelled;
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        cancelled.swap(queue);
+    }
+    for (const auto& request : cancelled)
+        finish(*request, RESPONSE_CANCELLED);
+}
+
+/**
+ * Removes a request from the pending requests and sends its response, so that its client can reuse its id as soon as
+ * it receives the response
+ * @param request the request
+ * @param status the status of the response (see server_response_status)
+ * @param voicing the notes of the solution, empty if there is none
+ * @param costs the costs of the solution, empty if there is none
+ * @param error the error message if the status is RESPONSE_INVALID
+ */
+void DiatonyServer::finish(const Request& request, const int status, const vector<int>& voicing,
+                           const vector<int>& costs, const string& error) {
+    {
+        std::lock_guard<std::mutex> guard(requestsLock);
+        requests.erase(std::make_pair(request.connection.get(), request.id));
+    }
+    respond(request, status, voicing, costs, error);
+}
+
+/**
+ * Solves a request and sends its response
+ * @param request the request
+ */
+void DiatonyServer::solve(Request& request) {
+    if (request.stop.is_cancelled()) {
+        finish(request, RESPONSE_CANCELLED);
+        return;
+    }
+    const double timeLimit = request.remaining_ms();
+    if (timeLimit <= 0) {
+        finish(request, RESPONSE_EXPIRED);
+        return;
+    }
+    vector<int> voicing, costs;
+    if (cache.find(request.problem, request.timeLimit, voicing, costs)) {
+        finish(request, RESPONSE_SOLVED, voicing, costs);
+        return;
+    }
+
+    try {
+        const DecodedProblem problem(request.problem);
+        FourVoiceTextureParameters* params = problem.get_parameters();
+        const DiatonySnapshot snapshot(params);
+
+        /// same search as solve_diatony without options (and its default cutoff), stopped by the request
+        Options options;
+        options.threads = 1;
+        options.stop = &request.stop;
+        options.nogoods_limit = params->get_totalNumberOfChords() * 4 * 4;
+        const DiatonySolution solution = solve_diatony(snapshot, &options, false, timeLimit);
+
+        if (request.stop.is_cancelled())
+            finish(request, RESPONSE_CANCELLED, solution.get_voicing(), solution.get_costs());
+        else if (solution.found()) {
+            cache.insert(request.problem, request.timeLimit, solution.get_voicing(), solution.get_costs());
+            finish(request, RESPONSE_SOLVED, solution.get_voicing(), solution.get_costs());
+        }
+        else
+            finish(request, RESPONSE_NO_SOLUTION);
+    }
+    catch (const std::exception& e) {
+        finish(request, RESPONSE_INVALID, {}, {}, e.what());
+    }
+}
+
+/**
+ * Sends the response to a request. Nothing is sent if the client disconnected.
+ * @param request the request
+ * @param status the status of the response (see server_response_status)
+ * @param voicing the notes of the solution, empty if there is none
+ * @param costs the costs of the solution, empty if there is none
+ * @param error the error message if the status is RESPONSE_INVALID
+ */
+void DiatonyServer::respond(const Request& request, const int status, const vector<int>& voicing,
+                            const vector<int>& costs, const string& error) {
+    string frame;
+    put_int(frame, 0); /// the length, written once the frame is complete
+    put_int(frame, SOLVE_RESPONSE);
+    put_int(frame, request.id);
+    put_int(frame, status);
+    put_int(frame, static_cast<int>(costs.size()));
+    for (const int cost : costs)
+        put_int(frame, cost);
+    put_int(frame, static_cast<int>(voicing.size()));
+    for (const int note : voicing)
+        put_int(frame, note);
+    frame += error;
+    string length;
+    put_int(length, static_cast<int>(frame.size()) - 4);
+    frame.replace(0, 4, length);
+
+    std::lock_guard<std::mutex> guard(request.connection->writeLock);
+    if (request.connection->open)
+        write_all(request.connection->fd, frame.data(), frame.size());
+}
@@ -0,0 +1,35 @@
+#include "../../headers/diatony/DiatonySnapshot.hpp"
+#include "../../headers/diatony/ParametersValidator.hpp"
+
+/**
+ * Constructor. Checks the parameters, then builds the model and propagates it at the root.
+ * @param params the parameters of the problem
+ * @param variableSelection the variable selection heuristic used by the branching (see variable_selection_heuristics)
+ * @param valueSelection the value selection heuristic used by the branching (see value_selection_heuristics)
+ * @param seed the seed used by random heuristics
+ * @throws std::invalid_argument if the parameters are invalid (see check_parameters)
+ */
+DiatonySnapshot::DiatonySnapshot(FourVoiceTextureParameters* params, const int variableSelection,
+                                 const int valueSelection, const unsigned int seed) : params(params) {
+    check_parameters(params);
+    root = new FourVoiceTexture(params, variableSelection, valueSelection, seed);
+    if (root->status() == SS_FAILED) {
+        delete root;
+        root = nullptr;
+    }
+}
+
+DiatonySnapshot::~DiatonySnapshot() {
+    delete root;
+}
+
+/**
+ * Returns a new copy of the propagated root space. This function is thread-safe.
+ * @return a clone of the root space owned by the caller, or nullptr if the problem has no solution
+ */
+FourVoiceTexture* DiatonySnapshot::clone() const {
+    if (root == nullptr)
+        return nullptr;
+    std::lock_guard<std::mutex> guard(lock);
+    return static_cast<FourVoiceTexture*>(root->clone());
+}
@@ -0,0 +1,32 @@
+#include "../../headers/diatony/DiatonySolution.hpp"
+
+/**
+ * Constructor. Extracts the values of a solution.
+ * @param sol a solution of the Four voice texture problem. It can be deleted afterwards.
+ * @param statistics the statistics of the search when the solution was found
+ */
+DiatonySolution::DiatonySolution(const FourVoiceTexture& sol, const Search::Statistics& statistics) :
+    voicing(sol.get_voicing_values()), costs(sol.get_cost_values()), statistics(statistics) {}
+
+/**
+ * Constructor
+ * @param voicing the notes of each voice for each chord [bass0, tenor0, alto0, soprano0, bass1, ...]
+ * @param costs the costs in lexicographical order
+ * @param statistics the statistics of the search when the solution was found
+ */
+DiatonySolution::DiatonySolution(vector<int> voicing, vector<int> costs, const Search::Statistics& statistics) :
+    voicing(std::move(voicing)), costs(std::move(costs)), statistics(statistics) {}
+
+/**
+ * to_string method for the DiatonySolution object.
+ * @return a string representation of the solution
+ */
+string DiatonySolution::to_string() const {
+    if (!found())
+        return "No solution\n";
+    string message;
+    message += "Voicing: {" + int_vector_to_string(voicing) + "}\n";
+    message += "Cost vector = {" + int_vector_to_string(costs) + "}\n";
+    message += statistics_to_string(statistics) + "\n";
+    return message;
+}
@@ -2,38 +2,34 @@
 // Created by Damien Sprockeels on 01/04/2025.
 //
 
+#include <random>
+
 #include "../../headers/diatony/FourVoiceTexture.hpp"
 
 /**
  * Constructor for FourVoiceTexture objects.
  * @param params An object containing the parameters for the whole piece.
+ * @param variableSelection the variable selection heuristic used by the branching (see variable_selection_heuristics)
+ * @param valueSelection the value selection heuristic used by the branching (see value_selection_heuristics)
+ * @param seed the seed used by random heuristics
  */
-FourVoiceTexture::FourVoiceTexture(FourVoiceTextureParameters* params) : params(params) {
+FourVoiceTexture::FourVoiceTexture(FourVoiceTextureParameters* params, const int variableSelection,
+                                   const int valueSelection, const unsigned int seed) : params(params) {
 
     /// General arrays initialization
     fullVoicing                             = IntVarArray(*this, nVoices * params->get_totalNumberOfChords(), BASS_MIN, SOPRANO_MAX);
+    pitchClasses                            = IntVarArray(*this, nVoices * params->get_totalNumberOfChords(), 0, PERFECT_OCTAVE - 1);
 
-    bassMelodicIntervals                    = IntVarArray(*this, params->get_totalNumberOfChords() - 1, -PERFECT_OCTAVE, PERFECT_OCTAVE);
-    tenorMelodicIntervals                   = IntVarArray(*this, params->get_totalNumberOfChords() - 1, -PERFECT_OCTAVE, PERFECT_OCTAVE);
-    altoMelodicIntervals                    = IntVarArray(*this, params->get_totalNumberOfChords() - 1, -PERFECT_OCTAVE, PERFECT_OCTAVE);
-    sopranoMelodicIntervals                 = IntVarArray(*this, params->get_totalNumberOfChords() - 1, -PERFECT_OCTAVE, PERFECT_OCTAVE);
     allMelodicIntervals                     = IntVarArray(*this, nVoices * (params->get_totalNumberOfChords() - 1), -PERFECT_OCTAVE, PERFECT_OCTAVE);
 
-    bassTenorHarmonicIntervals              = IntVarArray(*this, params->get_totalNumberOfChords(), 0, PERFECT_OCTAVE + PERFECT_FIFTH);
-    bassAltoHarmonicIntervals               = IntVarArray(*this, params->get_totalNumberOfChords(), 0, 2 * PERFECT_OCTAVE + PERFECT_FIFTH);
-    bassSopranoHarmonicIntervals            = IntVarArray(*this, params->get_totalNumberOfChords(), 0, 3 * PERFECT_OCTAVE + PERFECT_FIFTH);
-    tenorAltoHarmonicIntervals              = IntVarArray(*this, params->get_totalNumberOfChords(), 0, PERFECT_OCTAVE);
-    tenorSopranoHarmonicIntervals           = IntVarArray(*this, params->get_totalNumberOfChords(), 0, 2 * PERFECT_OCTAVE);
-    altoSopranoHarmonicIntervals            = IntVarArray(*this, params->get_totalNumberOfChords(), 0, PERFECT_OCTAVE);
+    /// Link between voicing and pitch classes, shared by all the rules on the pitch class of the notes
+    link_pitch_class_arrays(*this, fullVoicing, pitchClasses);
 
     /// Link between voicing and melodic intervals
-    link_melodic_arrays(*this, nVoices, this->params, fullVoicing, bassMelodicIntervals, altoMelodicIntervals,
-                        tenorMelodicIntervals, sopranoMelodicIntervals, allMelodicIntervals);
+    link_melodic_arrays(*this, nVoices, this->params, fullVoicing, allMelodicIntervals);
 
-    // link between voicing and harmonic intervals
-    link_harmonic_arrays(*this, nVoices, params->get_totalNumberOfChords(), fullVoicing,
-             bassTenorHarmonicIntervals, bassAltoHarmonicIntervals, bassSopranoHarmonicIntervals,
-             tenorAltoHarmonicIntervals, tenorSopranoHarmonicIntervals, altoSopranoHarmonicIntervals);
+    /// maximum space between adjacent voices
+    restrain_voices_spacing(*this, nVoices, params->get_totalNumberOfChords(), fullVoicing);
 
     /// Initialisation of the cost variable arrays
     costsAllMelodicIntervals                = IntVarArray(*this, nVoices * (params->get_totalNumberOfChords() - 1), UNISON_COST, MAX_MELODIC_COST);
@@ -69,22 +65,24 @@ FourVoiceTexture::FourVoiceTexture(FourVoiceTextureParameters* params) : params(
 
     /// count the number of common notes in the same voice between consecutive chords (cost to MAXIMIZE)
     /// /!\ The variable nOfCommonNotesInSameVoice has a NEGATIVE value so the minimization will maximize its absolute value
-    compute_cost_for_common_notes_not_in_same_voice(*this, bassMelodicIntervals, tenorMelodicIntervals,
-                                                    altoMelodicIntervals, sopranoMelodicIntervals, nOfUnisons,
+    compute_cost_for_common_notes_not_in_same_voice(*this, allMelodicIntervals, nOfUnisons,
                                                     commonNotesInSameVoice,
                                                     nOfCommonNotesInSameVoice);
     // Cost vector
     costVector = {nOfIncompleteChords, nOfFundStateDiminishedChordsWith4notes, nOfChordsWithLessThan4Values,
         costOfMelodicIntervals, nOfCommonNotesInSameVoice};
 
-    // forbid parallel intervals in the whole piece
-    forbid_parallel_intervals(
-        *this, this->params->get_totalNumberOfChords(), nVoices,
-        {PERFECT_FIFTH, PERFECT_OCTAVE, UNISON}, fullVoicing,
-        bassTenorHarmonicIntervals, bassAltoHarmonicIntervals,
-        bassSopranoHarmonicIntervals, tenorAltoHarmonicIntervals,
-        tenorSopranoHarmonicIntervals, altoSopranoHarmonicIntervals
-    );
+    /// the rules are posted through the registry so that each rule is posted once for each position
+    ConstraintRegistry registry(*this);
+
+    // forbid parallel intervals in the whole piece, one transition at a time so that the sections do not post them again
+    IntVarArgs voicing(fullVoicing);
+    for (int i = 0; i < params->get_totalNumberOfChords() - 1; i++) {
+        registry.post(PARALLEL_INTERVALS_RULE, i, [&]() {
+            forbid_parallel_intervals(*this, this->params->get_totalNumberOfChords(), nVoices,
+                {PERFECT_FIFTH, PERFECT_OCTAVE, UNISON}, voicing, i, i + 1);
+        });
+    }
 
     /// restrain the domain of the voices to their range + state that bass <= tenor <= alto <= soprano
     restrain_voices_domains(*this, nVoices, params->get_totalNumberOfChords(),
@@ -94,15 +92,10 @@ FourVoiceTexture::FourVoiceTexture(FourVoiceTextureParameters* params) : params(
 
     /// Creation of the subproblems for each progression
     for (int i = 0; i < params->get_numberOfSections(); i++) {
-        tonalProgressions.push_back(
-            new TonalProgression(*this, this->params->get_sectionParameters(i), fullVoicing,
-                bassMelodicIntervals, tenorMelodicIntervals,
-                altoMelodicIntervals, sopranoMelodicIntervals,
-                allMelodicIntervals, bassTenorHarmonicIntervals,
-                bassAltoHarmonicIntervals, bassSopranoHarmonicIntervals,
-                tenorAltoHarmonicIntervals, tenorSopranoHarmonicIntervals,
-                altoSopranoHarmonicIntervals, nDifferentValuesInDiminishedChord,
-                nOfDifferentNotesInChords, nIncompleteChordsForEachSection[i]));
+        tonalProgressions.push_back(std::make_shared<TonalProgression>(*this,
+            this->params->get_sectionParameters(i), fullVoicing, pitchClasses,
+            allMelodicIntervals, nDifferentValuesInDiminishedChord,
+            nOfDifferentNotesInChords, nIncompleteChordsForEachSection[i], registry));
     }
 
     /// Posting the modulation constraints
@@ -118,23 +111,21 @@ FourVoiceTexture::FourVoiceTexture(FourVoiceTextureParameters* params) : params(
                 const auto leading_tone = this->params->get_modulationParameters(i)->get_to()->get_tonality()->get_degree_note(SEVENTH_DEGREE);
                 const auto modulation_start = this->params->get_modulationParameters(i)->get_start();
 
+                RuleLiterals& literals = registry.get_literals();
                 for (int j = BASS; j <= SOPRANO; j++) {
-                    // the leading tone of the new tonality must be preceded by the note one semitone below it in the same voice
-                    rel(*this,
-                        expr(*this, fullVoicing[(modulation_start + 1) * nVoices + j] % PERFECT_OCTAVE == leading_tone),
-                        BOT_IMP,
-                        expr(*this, fullVoicing[modulation_start * nVoices + j] % PERFECT_OCTAVE == leading_tone - MINOR_SECOND),
-                        true
-                    );
-                    // If the note leading to the chromatism is doubled, the one not going to the leading tone must go down
-                    rel(*this,
-                        expr(*this, fullVoicing[modulation_start* nVoices + j]% PERFECT_OCTAVE ==
-                            (leading_tone + PERFECT_OCTAVE - MINOR_SECOND) % PERFECT_OCTAVE &&
-                            fullVoicing[(modulation_start + 1) * nVoices + j] % PERFECT_OCTAVE != leading_tone),
-                        BOT_IMP,
-                        expr(*this, allMelodicIntervals[modulation_start * nVoices + j] < 0),
-                        true
-                    );
+                    registry.post(CHROMATIC_MODULATION_RULE, modulation_start, j, j, [&]() {
+                        BoolVar isLeadingTone = literals.premise(pitchClasses[(modulation_start + 1) * nVoices + j], IRT_EQ,
+                            leading_tone);
+                        // the leading tone of the new tonality must be preceded by the note one semitone below it in the same voice
+                        literals.implies(isLeadingTone, pitchClasses[modulation_start * nVoices + j], IRT_EQ,
+                            leading_tone - MINOR_SECOND);
+                        // If the note leading to the chromatism is doubled, the one not going to the leading tone must go down
+                        literals.implies_all(BoolVarArgs({
+                                literals.premise(pitchClasses[modulation_start * nVoices + j], IRT_EQ,
+                                    (leading_tone + PERFECT_OCTAVE - MINOR_SECOND) % PERFECT_OCTAVE),
+                                literals.premise(pitchClasses[(modulation_start + 1) * nVoices + j], IRT_NQ, leading_tone)}),
+                            allMelodicIntervals[modulation_start * nVoices + j], IRT_LE, 0);
+                    });
                 }
                 break;
             }
@@ -146,14 +137,11 @@ FourVoiceTexture::FourVoiceTexture(FourVoiceTextureParameters* params) : params(
         }
     }
 
-    /// test constraints
+    constructionReport = registry.to_string();
 
-    /// go <-- bass->soprano
-    auto r_to_l = [](const Space& home, const IntVar& x, int i) {
-        return i;
-    };
+    /// test constraints
 
-    branch(*this, fullVoicing, INT_VAR_MERIT_MAX(r_to_l), INT_VAL_RND(1U));
+    post_branching(variableSelection, valueSelection, seed);
 }
 
 /**
@@ -163,23 +151,16 @@ FourVoiceTexture::FourVoiceTexture(FourVoiceTextureParameters* params) : params(
 FourVoiceTexture::FourVoiceTexture(FourVoiceTexture& s) : IntLexMinimizeSpace(s) {
     nVoices = s.nVoices;
     params = s.params;
+    sharedBound = s.sharedBound;
+    lns = s.lns;
+    lnsWindowSize = s.lnsWindowSize;
+    lnsSeed = s.lnsSeed;
 
     fullVoicing.update(*this, s.fullVoicing);
-
-    bassMelodicIntervals.update(*this, s.bassMelodicIntervals);
-    tenorMelodicIntervals.update(*this, s.tenorMelodicIntervals);
-    altoMelodicIntervals.update(*this, s.altoMelodicIntervals);
-    sopranoMelodicIntervals.update(*this, s.sopranoMelodicIntervals);
+    pitchClasses.update(*this, s.pitchClasses);
 
     allMelodicIntervals.update(*this, s.allMelodicIntervals);
 
-    bassTenorHarmonicIntervals.update(*this, s.bassTenorHarmonicIntervals);
-    bassAltoHarmonicIntervals.update(*this, s.bassAltoHarmonicIntervals);
-    bassSopranoHarmonicIntervals.update(*this, s.bassSopranoHarmonicIntervals);
-    tenorAltoHarmonicIntervals.update(*this, s.tenorAltoHarmonicIntervals);
-    tenorSopranoHarmonicIntervals.update(*this, s.tenorSopranoHarmonicIntervals);
-    altoSopranoHarmonicIntervals.update(*this, s.altoSopranoHarmonicIntervals);
-
     nOfUnisons.update( *this, s.nOfUnisons);
 
     /// cost-related arrays
@@ -201,8 +182,54 @@ FourVoiceTexture::FourVoiceTexture(FourVoiceTexture& s) : IntLexMinimizeSpace(s)
     costVector = {nOfIncompleteChords, nOfFundStateDiminishedChordsWith4notes, nOfChordsWithLessThan4Values,
         costOfMelodicIntervals, nOfCommonNotesInSameVoice};
 
-    for (auto p : s.tonalProgressions)
-        tonalProgressions.push_back(new TonalProgression(*this, *p));
+    tonalProgressions = s.tonalProgressions;
+}
+
+/**
+ * Posts the branching on the voicing of the piece
+ * @param variableSelection the variable selection heuristic (see variable_selection_heuristics)
+ * @param valueSelection the value selection heuristic (see value_selection_heuristics)
+ * @param seed the seed used for random heuristics
+ */
+void FourVoiceTexture::post_branching(const int variableSelection, const int valueSelection, const unsigned int seed) {
+    /// the chord brancher chooses its values from the costs, so the value selection is ignored
+    if (variableSelection == CHORD_COST_GUIDED) {
+        chord_branch(*this, fullVoicing, params);
+        return;
+    }
+    IntValBranch valueBranching;
+    switch (valueSelection) {
+        case VAL_RND:   valueBranching = INT_VAL_RND(Rnd(seed));   break;
+        case VAL_MIN:   valueBranching = INT_VAL_MIN();            break;
+        case VAL_MAX:   valueBranching = INT_VAL_MAX();            break;
+        case VAL_MED:   valueBranching = INT_VAL_MED();            break;
+        default:
+            throw std::invalid_argument("Unknown value selection heuristic: " + std::to_string(valueSelection));
+    }
+    switch (variableSelection) {
+        case RIGHT_TO_LEFT: {
+            /// go <-- bass->soprano
+            auto r_to_l = [](const Space& home, const IntVar& x, int i) {
+                return i;
+            };
+            branch(*this, fullVoicing, INT_VAR_MERIT_MAX(r_to_l), valueBranching);
+            break;
+        }
+        case LEFT_TO_RIGHT: branch(*this, fullVoicing, INT_VAR_NONE(), valueBranching);          break;
+        case DOM_SIZE_MIN:  branch(*this, fullVoicing, INT_VAR_SIZE_MIN(), valueBranching);      break;
+        case DEGREE_MAX:    branch(*this, fullVoicing, INT_VAR_DEGREE_MAX(), valueBranching);    break;
+        default:
+            throw std::invalid_argument("Unknown variable selection heuristic: " + std::to_string(variableSelection));
+    }
+}
+
+/**
+ * Constrains the cost vector to be strictly lower than the best cost found by the engines sharing the bound, if any
+ */
+void FourVoiceTexture::post_shared_bound() {
+    vector<int> bound;
+    if (sharedBound != nullptr && sharedBound->get(bound))
+        rel(*this, costVector, IRT_LE, IntArgs(bound));
 }
 
 /**
@@ -222,16 +249,182 @@ IntVarArgs FourVoiceTexture::cost() const {
 }
 
 /**
- * Returns the values taken by the variables vars in a solution as a pointer to an integer array
- * @return an array of integers representing the values of the variables in a solution
+ * Constrain function for branch and bound search. Posts the cost of the best solution found by this engine, and
+ * the shared bound if there is a better one.
+ * @param best the best solution found so far by the engine
+ */
+void FourVoiceTexture::constrain(const Space& best) {
+    IntLexMinimizeSpace::constrain(best);
+    post_shared_bound();
+}
+
+/**
+ * Master configuration for restart-based search. Also posts the shared bound, so that each restart starts from
+ * the best cost found by all the engines.
+ * @param mi the meta information about the restart
+ * @return true if the search must restart, false otherwise
+ */
+bool FourVoiceTexture::master(const MetaInfo& mi) {
+    const bool restart = IntLexMinimizeSpace::master(mi);
+    post_shared_bound();
+    return restart;
+}
+
+/**
+ * Fixes the voicing of the piece to the given values, e.g. to check a voicing found by another solver. The
+ * constraints are only posted, propagation happens on the next call to status().
+ * @param voicing the notes of each voice for each chord [bass0, tenor0, alto0, soprano0, bass1, ...]
+ */
+void FourVoiceTexture::constrain_voicing(const vector<int>& voicing) {
+    if (static_cast<int>(voicing.size()) != fullVoicing.size())
+        throw std::invalid_argument("The voicing has " + std::to_string(voicing.size()) + " notes, expected " +
+            std::to_string(fullVoicing.size()));
+    for (int i = 0; i < fullVoicing.size(); i++)
+        rel(*this, fullVoicing[i], IRT_EQ, voicing[i]);
+}
+
+/**
+ * Constrains the cost vector to be lexicographically strictly lower than a bound, e.g. the cost of a solution found
+ * by a heuristic
+ * @param bound the costs in lexicographical order
+ */
+void FourVoiceTexture::constrain_costs(const vector<int>& bound) {
+    if (static_cast<int>(bound.size()) != costVector.size())
+        throw std::invalid_argument("The bound has " + std::to_string(bound.size()) + " costs, expected " +
+            std::to_string(costVector.size()));
+    rel(*this, costVector, IRT_LE, IntArgs(bound));
+}
+
+/**
+ * Forbids a set of chords to take the given voicings all at once. At least one note of one of the chords must
+ * differ from the given voicing.
+ * @param chords the positions of the chords in the piece
+ * @param voicing the forbidden notes of each chord [bass, tenor, alto, soprano of chords[0], bass of chords[1], ...]
+ */
+void FourVoiceTexture::forbid_chords_voicing(const vector<int>& chords, const vector<int>& voicing) {
+    if (voicing.size() != nVoices * chords.size())
+        throw std::invalid_argument("The forbidden voicing has " + std::to_string(voicing.size()) + " notes, expected " +
+            std::to_string(nVoices * chords.size()));
+    BoolVarArgs differentNotes;
+    for (int c = 0; c < static_cast<int>(chords.size()); c++)
+        for (int v = BASS; v <= SOPRANO; v++)
+            differentNotes << expr(*this, fullVoicing[chords[c] * nVoices + v] != voicing[c * nVoices + v]);
+    rel(*this, BOT_OR, differentNotes, 1);
+}
+
+/**
+ * Restricts the voicing of a section to one of the given candidates
+ * @param section the index of the section
+ * @param candidates the allowed voicings of the section, each one having 4 notes per chord of the section
+ */
+void FourVoiceTexture::restrict_section_voicing(const int section, const vector<vector<int>>& candidates) {
+    const int start = params->get_sectionStart(section);
+    const int sectionSize = params->get_sectionEnd(section) - start + 1;
+    IntVarArgs sectionVoicing;
+    for (int i = start * nVoices; i < (start + sectionSize) * nVoices; i++)
+        sectionVoicing << fullVoicing[i];
+
+    TupleSet allowed(nVoices * sectionSize);
+    for (const auto& candidate : candidates) {
+        if (static_cast<int>(candidate.size()) != nVoices * sectionSize)
+            throw std::invalid_argument("A candidate voicing of section " + std::to_string(section) + " has " +
+                std::to_string(candidate.size()) + " notes, expected " + std::to_string(nVoices * sectionSize));
+        allowed.add(IntArgs(candidate));
+    }
+    allowed.finalize();
+    extensional(*this, sectionVoicing, allowed);
+}
+
+/**
+ * Turns restart-based search on this space into a Large Neighbourhood Search. After the first solution, each
+ * restart keeps the incumbent voicing and only relaxes a neighbourhood of it (see lns_neighbourhoods).
+ * @param windowSize the maximum number of consecutive chords relaxed at each restart
+ * @param seed the seed used to pick the neighbourhoods
+ */
+void FourVoiceTexture::set_lns(const int windowSize, const unsigned int seed) {
+    if (windowSize < 1)
+        throw std::invalid_argument("The LNS window size must be at least 1, got " + std::to_string(windowSize));
+    lns = true;
+    lnsWindowSize = windowSize;
+    lnsSeed = seed;
+}
+
+/**
+ * Slave configuration for restart-based search. In LNS mode, fixes every voicing variable outside of a randomly
+ * chosen neighbourhood to its value in the last solution found.
+ * @param mi the meta information about the restart
+ * @return true if the search on the slave is complete (no neighbourhood was relaxed), false otherwise
  */
-int* FourVoiceTexture::return_solution() const{
-    int size = params->get_totalNumberOfChords();
-    int* solution = new int[size*4];
-    for(int i = 0; i < 4*size; i++){
-        solution[i] = fullVoicing[i].val();
+bool FourVoiceTexture::slave(const MetaInfo& mi) {
+    /// the first restart (and any restart before the first solution) explores the whole problem
+    if (!lns || mi.type() != MetaInfo::RESTART || mi.last() == nullptr)
+        return true;
+    const auto& incumbent = static_cast<const FourVoiceTexture&>(*mi.last());
+    const int nChords = params->get_totalNumberOfChords();
+
+    /// the neighbourhood only depends on the seed and the restart number, so that the search is reproducible
+    std::mt19937 generator(lnsSeed + static_cast<unsigned int>(mi.restart()));
+    int neighbourhood = static_cast<int>(generator() % 3);
+    if (neighbourhood == LNS_SECTION_BOUNDARY && params->get_numberOfSections() < 2)
+        neighbourhood = LNS_CHORD_WINDOW;
+    /// relax between half the window and the whole window
+    const int window = std::min(nChords, lnsWindowSize - static_cast<int>(generator() % (lnsWindowSize / 2 + 1)));
+
+    int first = 0, last = 0;   // the relaxed chords [first, last)
+    int voice = -1;             // the relaxed voice, -1 if all voices are relaxed
+    switch (neighbourhood) {
+        case LNS_SINGLE_VOICE: {
+            /// a single voice is much more constrained, so it can be relaxed on a wider window
+            const int voiceWindow = std::min(nChords, 2 * window);
+            voice = static_cast<int>(generator() % nVoices);
+            first = static_cast<int>(generator() % (nChords - voiceWindow + 1));
+            last = first + voiceWindow;
+            break;
+        }
+        case LNS_SECTION_BOUNDARY: {
+            const int section = 1 + static_cast<int>(generator() % (params->get_numberOfSections() - 1));
+            first = std::max(0, params->get_sectionStart(section) - window / 2);
+            last = std::min(nChords, first + window);
+            break;
+        }
+        default:
+            first = static_cast<int>(generator() % (nChords - window + 1));
+            last = first + window;
+            break;
+    }
+
+    for (int chord = 0; chord < nChords; chord++) {
+        for (int v = BASS; v <= SOPRANO; v++) {
+            if (chord >= first && chord < last && (voice == -1 || voice == v))
+                continue;
+            rel(*this, fullVoicing[chord * nVoices + v], IRT_EQ, incumbent.fullVoicing[chord * nVoices + v].val());
+        }
     }
-    return solution;
+    return false;
+}
+
+/**
+ * Returns the values of the cost variables in a solution
+ * @return a vector containing the value of each cost in lexicographical order
+ */
+vector<int> FourVoiceTexture::get_cost_values() const {
+    vector<int> costs;
+    costs.reserve(costVector.size());
+    for (int i = 0; i < costVector.size(); i++)
+        costs.push_back(costVector[i].val());
+    return costs;
+}
+
+/**
+ * Returns the values of the voicing variables in a solution
+ * @return a vector containing the notes of each voice for each chord [bass0, tenor0, alto0, soprano0, bass1, ...]
+ */
+vector<int> FourVoiceTexture::get_voicing_values() const {
+    vector<int> voicing;
+    voicing.reserve(fullVoicing.size());
+    for (int i = 0; i < fullVoicing.size(); i++)
+        voicing.push_back(fullVoicing[i].val());
+    return voicing;
 }
 
 /**
@@ -243,25 +436,13 @@ string FourVoiceTexture::to_string() const {
     message += "Four Voice Texture object:\n";
     message += "Parameters: " + params->toString() + "\n";
     message += "Tonal Progressions:\n";
-    for (auto p : tonalProgressions) {
-        message += p->to_string() + "\n";
+    for (const auto& p : tonalProgressions) {
+        message += p->to_string(fullVoicing, allMelodicIntervals, nDifferentValuesInDiminishedChord,
+            nOfDifferentNotesInChords) + "\n";
     }
     message += "Full voicing array:" + intVarArray_to_string(fullVoicing) + "\n\n";
 
-    message += "Bass Melodic Intervals:\n" + intVarArray_to_string(bassMelodicIntervals) + "\n";
-    message += "Tenor Melodic Intervals:\n" + intVarArray_to_string(tenorMelodicIntervals) + "\n";
-    message += "Alto Melodic Intervals:\n" + intVarArray_to_string(altoMelodicIntervals) + "\n";
-    message += "Soprano Melodic Intervals:\n" + intVarArray_to_string(sopranoMelodicIntervals) + "\n";
-
-    message += "All Melodic Intervals:\n" + intVarArray_to_string(allMelodicIntervals) + "\n";
-
-    message += "Bass-Tenor Harmonic Intervals:\n" + intVarArray_to_string(bassTenorHarmonicIntervals) + "\n";
-    message += "Bass-Alto Harmonic Intervals:\n" + intVarArray_to_string(bassAltoHarmonicIntervals) + "\n";
-    message += "Bass-Soprano Harmonic Intervals:\n" + intVarArray_to_string(bassSopranoHarmonicIntervals) + "\n";
-    message += "Tenor-Alto Harmonic Intervals:\n" + intVarArray_to_string(tenorAltoHarmonicIntervals) + "\n";
-    message += "Tenor-Soprano Harmonic Intervals:\n" + intVarArray_to_string(tenorSopranoHarmonicIntervals) + "\n";
-    message += "Alto-Soprano Harmonic Intervals:\n" + intVarArray_to_string(altoSopranoHarmonicIntervals) + "\n\n";
-
+    message += "All Melodic Intervals:\n" + intVarArray_to_string(allMelodicIntervals) + "\n\n";
     message += "-------------------------------cost-related auxiliary arrays------------------------------\n";
 
     message += "nDifferentValuesInDiminishedChord = \t" + intVarArray_to_string(nDifferentValuesInDiminishedChord) + "\n";
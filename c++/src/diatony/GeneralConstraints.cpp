@@ -9,7 +9,8 @@
  * This file contains all the general constraints. It currently contains:                                              *
  *     - link_melodic_arrays: links the melodic intervals arrays to the fullChordsVoicing array for each voice         *
  *     - link_squared_melodic_arrays: links the absolute melodic intervals arrays to the corresponding melodic arrays *
- *     - link_harmonic_arrays: links the harmonic intervals arrays to the fullChordsVoicing array for each voice       *
+ *     - restrain_voices_spacing: restrains the space between adjacent voices                                          *
+ *     - link_pitch_class_arrays: links the pitch class array to the fullChordsVoicing array                           *
  *     - restrain_voices_domains: sets the domains of the different voices to their range and gives them their order   *
  *                                                                                                                     *
  ***********************************************************************************************************************/
@@ -39,63 +40,59 @@ void restrain_voices_domains(const Home &home, const int nVoices, const int n, c
 }
 
 /**
- * Link the melodic intervals arrays to the fullChordsVoicing array
+ * Link the melodic intervals array to the fullChordsVoicing array. The melodic intervals of a single voice are the
+ * slice allMelodicIntervals.slice(voice, nVoices), no other array is needed.
  * @param home The instance of the problem
  * @param nVoices the number of voices
  * @param params the parameters of the progression
  * @param fullChordsVoicing the array containing all the chords in the form [bass0, alto0, tenor0, soprano0, bass1, ...]
- * @param bassMelodicIntervals the melodic intervals of the bass
- * @param tenorMelodicIntervals the melodic intervals of the tenor
- * @param altoMelodicIntervals the melodic intervals of the alto
- * @param sopranoMelodicIntervals the melodic intervals of the soprano
- * @param allMelodicIntervals the array containing all the melodic intervals in the form
+ * @param allMelodicIntervals the array containing all the melodic intervals in the form [bass0, tenor0, alto0,
+ * soprano0, bass1, ...], where the interval i is between chord i and chord i+1
  */
 void link_melodic_arrays(const Home &home, const int nVoices, const FourVoiceTextureParameters* params,
-                         IntVarArray &fullChordsVoicing, IntVarArray &bassMelodicIntervals,
-                         IntVarArray &altoMelodicIntervals, IntVarArray &tenorMelodicIntervals,
-                         IntVarArray &sopranoMelodicIntervals, IntVarArray &allMelodicIntervals) {
-    const auto size = params->get_totalNumberOfChords();
-    // link each of the voice's melodic interval arrays
-    for (int i = 0; i < size - 1; ++i){
-        rel(home, bassMelodicIntervals[i]    == fullChordsVoicing[(i + 1) * nVoices + BASS]    - fullChordsVoicing[i * nVoices + BASS]);
-        rel(home, tenorMelodicIntervals[i]   == fullChordsVoicing[(i + 1) * nVoices + TENOR]   - fullChordsVoicing[i * nVoices + TENOR]);
-        rel(home, altoMelodicIntervals[i]    == fullChordsVoicing[(i + 1) * nVoices + ALTO]    - fullChordsVoicing[i * nVoices + ALTO]);
-        rel(home, sopranoMelodicIntervals[i] == fullChordsVoicing[(i + 1) * nVoices + SOPRANO] - fullChordsVoicing[i * nVoices + SOPRANO]);
-    }
-    // link the allMelodicIntervals array
-    for(int i = 0; i < params->get_totalNumberOfChords()-1; i++){
-        rel(home, expr(home, allMelodicIntervals[nVoices * i + BASS]            == bassMelodicIntervals[i]));
-        rel(home, expr(home, allMelodicIntervals[nVoices * i + TENOR]           == tenorMelodicIntervals[i]));
-        rel(home, expr(home, allMelodicIntervals[nVoices * i + ALTO]            == altoMelodicIntervals[i]));
-        rel(home, expr(home, allMelodicIntervals[nVoices * i + SOPRANO]         == sopranoMelodicIntervals[i]));
-    }
+                         IntVarArray &fullChordsVoicing, IntVarArray &allMelodicIntervals) {
+    for (int i = 0; i < params->get_totalNumberOfChords() - 1; ++i)
+        for (int voice = BASS; voice <= SOPRANO; voice++)
+            rel(home, allMelodicIntervals[nVoices * i + voice] ==
+                fullChordsVoicing[(i + 1) * nVoices + voice] - fullChordsVoicing[i * nVoices + voice]);
 }
 
 /**
- * Link the harmonic intervals arrays to the fullChordsVoicing array for each voice
+ * Restrains the space between adjacent voices: at most an octave and a fifth between the bass and the tenor, and at most
+ * an octave between the tenor and the alto and between the alto and the soprano. The harmonic intervals are not stored
+ * in variables, the constraints are posted directly on the notes.
  * @param home the instance of the problem
  * @param nVoices the number of voices in the chords
  * @param size the number of chords
  * @param fullChordsVoicing the array containing all the chords in the form [bass0, alto0, tenor0, soprano0, bass1, ...]
- * @param bassTenorHarmonicIntervals the harmonic intervals between bass and tenor
- * @param bassAltoHarmonicIntervals the harmonic intervals between bass and alto
- * @param bassSopranoHarmonicIntervals the harmonic intervals between bass and soprano
- * @param tenorAltoHarmonicIntervals the harmonic intervals between tenor and alto
- * @param tenorSopranoHarmonicIntervals the harmonic intervals between tenor and soprano
- * @param altoSopranoHarmonicIntervals the harmonic intervals between alto and soprano
  */
-void link_harmonic_arrays(const Home &home, const int nVoices, const int size, IntVarArray fullChordsVoicing,
-                          IntVarArray bassTenorHarmonicIntervals,    IntVarArray bassAltoHarmonicIntervals,
-                          IntVarArray bassSopranoHarmonicIntervals,  IntVarArray tenorAltoHarmonicIntervals,
-                          IntVarArray tenorSopranoHarmonicIntervals, IntVarArray altoSopranoHarmonicIntervals) {
+void restrain_voices_spacing(const Home &home, const int nVoices, const int size, const IntVarArray &fullChordsVoicing) {
     for(int i = 0; i < size; ++i){
-        rel(home, bassTenorHarmonicIntervals[i] == fullChordsVoicing[(nVoices * i) + TENOR] - fullChordsVoicing[nVoices * i + BASS]);
-        rel(home, bassAltoHarmonicIntervals[i] == fullChordsVoicing[(nVoices * i) + ALTO] - fullChordsVoicing[nVoices * i + BASS]);
-        rel(home, bassSopranoHarmonicIntervals[i] == fullChordsVoicing[(nVoices * i) + SOPRANO] - fullChordsVoicing[nVoices * i + BASS]);
-
-        rel(home, tenorAltoHarmonicIntervals[i] == fullChordsVoicing[(nVoices * i) + ALTO] - fullChordsVoicing[(nVoices * i) + TENOR]);
-        rel(home, tenorSopranoHarmonicIntervals[i] == fullChordsVoicing[(nVoices * i) + SOPRANO] - fullChordsVoicing[(nVoices * i) + TENOR]);
-
-        rel(home, altoSopranoHarmonicIntervals[i] == fullChordsVoicing[(nVoices * i) + SOPRANO] - fullChordsVoicing[(nVoices * i) + ALTO]);
+        linear(home, IntArgs({1, -1}), IntVarArgs({fullChordsVoicing[nVoices * i + TENOR],
+            fullChordsVoicing[nVoices * i + BASS]}), IRT_LQ, PERFECT_OCTAVE + PERFECT_FIFTH);
+        linear(home, IntArgs({1, -1}), IntVarArgs({fullChordsVoicing[nVoices * i + ALTO],
+            fullChordsVoicing[nVoices * i + TENOR]}), IRT_LQ, PERFECT_OCTAVE);
+        linear(home, IntArgs({1, -1}), IntVarArgs({fullChordsVoicing[nVoices * i + SOPRANO],
+            fullChordsVoicing[nVoices * i + ALTO]}), IRT_LQ, PERFECT_OCTAVE);
     }
-}
\ No newline at end of file
+}
+
+/**
+ * Link the pitch class array to the fullChordsVoicing array. The rules that only depend on the pitch class of a note
+ * read it from this array instead of posting their own modulo.
+ * @param home the instance of the problem
+ * @param fullChordsVoicing the array containing all the chords in the form [bass0, alto0, tenor0, soprano0, bass1, ...]
+ * @param pitchClasses the pitch class of each note of fullChordsVoicing, in [0,11]
+ */
+void link_pitch_class_arrays(const Home &home, const IntVarArray &fullChordsVoicing, IntVarArray &pitchClasses) {
+    /// [note, pitch class] for every note in the range of the voices, built once and shared by all the spaces
+    static const TupleSet notes = [] {
+        TupleSet table(2);
+        for (int note = BASS_MIN; note <= SOPRANO_MAX; note++)
+            table.add(IntArgs({note, note % PERFECT_OCTAVE}));
+        table.finalize();
+        return table;
+    }();
+    for (int i = 0; i < fullChordsVoicing.size(); i++)
+        extensional(home, IntVarArgs({fullChordsVoicing[i], pitchClasses[i]}), notes);
+}
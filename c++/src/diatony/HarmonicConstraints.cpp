@@ -8,305 +8,40 @@
 /***********************************************************************************************************************
  *                                                                                                                     *
  * This file contains all the harmonic constraints, that is constraints within a given chord.                          *
- * It currently contains the following constraints:                                                                    *
- *      - set_to_chord: sets the domain of the current chord based on the tonality and the scale degree                *
- *      - set_bass: sets the bass of the chord according to the state of the chord                                     *
- *      - chord_note_occurrence_fundamental_state: sets the number of times each note in the chord are present for     *
- *          fundamental state chords                                                                                   *
- *      - chord_note_occurrence_first_inversion: sets the number of times each note in the chord are present for       *
- *          first inversion chords                                                                                     *
- *      - chord_note_occurrence_second_inversion: sets the number of times each note in the chord are present for      *
- *          second inversion chords                                                                                    *
- *      - chord_note_occurrence_third_inversion: sets the number of times each note in the chord are present for       *
- *          third inversion chords                                                                                     *
+ * The notes of each chord are set by its voicing table (see get_chord_voicing_table), whose rules are checked by      *
+ * ChainModel::respects_note_occurrences. It currently contains the following constraints:                             *
+ *      - double_third_on_contrary_motion: doubles the third of an interior first inversion chord depending on the     *
+ *          motion of the bass and the soprano around it                                                               *
  *                                                                                                                     *
  ***********************************************************************************************************************/
 
 /**
- * Set the notes of the fullChordsVoicing array to the notes of the given chord
+ * Doubles the third of an interior first inversion chord if and only if the bass rises and the soprano falls by step
+ * both before and after the chord. Otherwise, the third is present exactly once.
  * @param home the instance of the problem
- * @param tonality the tonality of the piece
- * @param degree the degree of the chord
- * @param quality the quality of the chord
- * @param currentChord the array containing a chord in the form [bass, alto, tenor, soprano]
- */
-void set_to_chord(const Home& home, Tonality* tonality, int degree, int quality, const IntVarArgs& currentChord){
-    IntSet set(get_all_notes_in_chord(tonality->get_degree_note(degree), quality));
-    dom(home, currentChord, set);
-}
-
-/**
- * Set the bass of the chord to be the given note
- * @param home the instance of the problem
- * @param tonality the tonality of the piece
- * @param degree the degree of the chord
- * @param quality the quality of the chord
- * @param state the state of the chord
- * @param currentChord the array containing a chord in the form [bass, alto, tenor, soprano]
- */
-void set_bass(const Home &home, Tonality *tonality, int degree, int quality, int state, IntVarArgs currentChord) {
-    auto diff = get_interval_from_root(quality, state);
-    dom(home, currentChord[0], IntSet(get_all_given_note((tonality->get_degree_note(degree) + diff) % PERFECT_OCTAVE)));
-}
-
-/**
- * Sets the number of times each note of the notes of the chord is present in the chord
- * @param home the instance of the problem
- * @param degree the degree of the chord
- * @param quality the quality of the chord
+ * @param literals the literals shared by all the rules of the space (see ConstraintRegistry::get_literals)
  * @param nVoices the number of voices
- * @param pos the current position in the chord progression
- * @param tonality the tonality of the piece
- * @param nDifferentValuesInDiminishedChord the number of different values in the diminished chord
- * @param nOfNotesInChord the number of different notes in the chord based on its quality
- * @param currentChord the array containing a chord in the form [bass, alto, tenor, soprano]
- */
-void chord_note_occurrence_fundamental_state(Home home, int nVoices, int pos, vector<int> degrees, vector<int> qualities,
-                                             Tonality *tonality, const IntVarArgs &currentChord,
-                                             const IntVar &nDifferentValuesInDiminishedChord,
-                                             const IntVar &nOfNotesInChord) {
-
-    auto root   = tonality->get_degree_note(degrees[pos]);
-    auto third  = (root + get_interval_from_root(qualities[pos],THIRD)) % PERFECT_OCTAVE;
-    auto fifth  = (root + get_interval_from_root(qualities[pos],FIFTH)) % PERFECT_OCTAVE;
-
-    /// if the chord is a diminished seventh degree
-    if(degrees[pos] == SEVENTH_DEGREE && qualities[pos] == DIMINISHED_CHORD){
-        /// If there are 4 different notes, then the third must be doubled. Otherwise any note can be doubled as
-        /// there are only 3 values
-        IntVar nOfThirds(home,0,nVoices);
-        count(home, currentChord, IntSet(get_all_given_note(third)),    IRT_EQ,nOfThirds);
-        /// if there are 4 different notes, then the third must be doubled
-        rel(home,
-            expr(home, nDifferentValuesInDiminishedChord == nVoices),
-            BOT_IMP,
-            expr(home, nOfThirds == 2),
-            true
-        );
-        /// each note is present at least once, doubling is determined by the costs
-        count(home, currentChord, IntSet(get_all_given_note(root)),     IRT_GQ,1);
-        count(home, currentChord, IntSet(get_all_given_note(third)),    IRT_GQ,1);
-        count(home, currentChord, IntSet(get_all_given_note(fifth)),    IRT_GQ,1);
-    }
-    else if (degrees[pos] == FLAT_TWO) {
-        count(home, currentChord, IntSet(get_all_given_note(root)),     IRT_EQ,1);
-        count(home, currentChord, IntSet(get_all_given_note(third)),    IRT_EQ,2);
-        count(home, currentChord, IntSet(get_all_given_note(fifth)),    IRT_GQ,1);
-    }
-    else if (degrees[pos] == AUGMENTED_SIXTH) {
-        count(home, currentChord, IntSet(get_all_given_note(root)),     IRT_EQ,1);
-        count(home, currentChord, IntSet(get_all_given_note(third)),    IRT_EQ,2);
-        count(home, currentChord, IntSet(get_all_given_note(fifth)),    IRT_EQ,1);
-    }
-    /// special rule for sixth degree because in the case of an interrupted cadence,
-    /// the third of the chord is doubled instead of the fundamental
-    else if(degrees[pos] == SIXTH_DEGREE && pos > 0 && degrees[pos-1] == FIFTH_DEGREE){
-        count(home, currentChord, IntSet(get_all_given_note(root)),     IRT_EQ,1);
-        count(home, currentChord, IntSet(get_all_given_note(third)),    IRT_EQ,2);
-        count(home, currentChord, IntSet(get_all_given_note(fifth)),    IRT_EQ,1);
-    }
-    /// Dominant chords -> the dominant chord or the next chord can be incomplete to avoid // fifths/octaves
-    else if(degrees[pos] == FIFTH_DEGREE || (degrees[pos] >= FIVE_OF_TWO && degrees[pos] <= FIVE_OF_SEVEN)){
-        count(home, currentChord, IntSet(get_all_given_note(root)),     IRT_GQ,1);
-        count(home, currentChord, IntSet(get_all_given_note(third)),    IRT_EQ,1);
-        count(home, currentChord, IntSet(get_all_given_note(fifth)),    IRT_LQ,1);
-
-        if(qualities[pos] >= DOMINANT_SEVENTH_CHORD){ // if the chord has a seventh
-            auto seventh = (root + get_interval_from_root(qualities[pos],SEVENTH)) % PERFECT_OCTAVE;
-            /// the seventh must be present
-            count(home, currentChord, IntSet(get_all_given_note(seventh)),  IRT_EQ, 1);
-            /// if the chord is incomplete, double the bass
-            BoolVar isIncomplete(expr(home, nOfNotesInChord < 4));
-            IntVar nOfBassNotes(home,0,nVoices);
-            count(home, currentChord, IntSet(get_all_given_note(root)), IRT_EQ,nOfBassNotes);
-            rel(home, isIncomplete, BOT_EQV, expr(home, nOfBassNotes == 2), true);
-        }
-    }
-    else if(degrees[pos] == FIRST_DEGREE){
-        count(home, currentChord, IntSet(get_all_given_note(root)),     IRT_GQ,1);
-        count(home, currentChord, IntSet(get_all_given_note(third)),    IRT_EQ,1);
-        count(home, currentChord, IntSet(get_all_given_note(fifth)),    IRT_LQ,1);
-        /// if the chord is incomplete, then the bass must be tripled and the third should be there once.
-        BoolVar isIncomplete(expr(home, nOfNotesInChord < 3));
-        IntVar nOfBassNotes(home,0,nVoices);
-        count(home, currentChord, IntSet(get_all_given_note(root)), IRT_EQ,nOfBassNotes);
-        rel(home, isIncomplete, BOT_EQV, expr(home, nOfBassNotes == 3), true);
-        if(qualities[pos] >= DOMINANT_SEVENTH_CHORD){
-            auto seventh = (root + get_interval_from_root(qualities[pos],SEVENTH)) % PERFECT_OCTAVE;
-            /// the seventh must be present
-            count(home, currentChord, IntSet(get_all_given_note(seventh)), IRT_EQ, 1);
-        }
-    }
-    else{
-        /// each note is present at least once, the bass is present at least once, the third exactly once and the
-        /// fifth at most once
-        count(home, currentChord, IntSet(get_all_given_note(root)),     IRT_GQ,1);
-        count(home, currentChord, IntSet(get_all_given_note(third)),    IRT_EQ,1);
-        count(home, currentChord, IntSet(get_all_given_note(fifth)),    IRT_LQ,1);
-
-        if(qualities[pos] >= DOMINANT_SEVENTH_CHORD){
-            auto seventh = (root + get_interval_from_root(qualities[pos],SEVENTH)) % PERFECT_OCTAVE;
-            /// the seventh must be present
-            count(home, currentChord, IntSet(get_all_given_note(seventh)), IRT_EQ, 1);
-        }
-        else{
-            /// the fifth must be present exactly once
-            count(home, currentChord, IntSet(get_all_given_note(fifth)), IRT_EQ, 1);
-        }
-    }
-}
-
-/**
- * Sets the number of times each note of the chord is present in the chord
- * @param home the instance of the problem
- * @param size the size of the chord progression
- * @param nVoices the number of voices
- * @param currentPos the current position in the chord progression
- * @param tonality the tonality of the piece
- * @param degrees the degree of the chord
- * @param qualities the quality of the chord
+ * @param currentPos the current position in the chord progression. It cannot be the first or the last chord.
+ * @param third the third of the chord (as a note in [0,11])
  * @param currentChord the array containing a chord in the form [bass, alto, tenor, soprano]
  * @param bassMelodicIntervals the array containing the melodic intervals of the bass
  * @param sopranoMelodicIntervals the array containing the melodic intervals of the soprano
  */
-void chord_note_occurrence_first_inversion(Home home, int size, int nVoices, int currentPos, Tonality *tonality,
-                                           vector<int> degrees, vector<int> qualities,
-                                           const IntVarArgs &currentChord, IntVarArray &bassMelodicIntervals,
-                                           IntVarArray &sopranoMelodicIntervals){
-    auto root   = tonality->get_degree_note(degrees[currentPos]);
-    auto third  = (root + get_interval_from_root(qualities[currentPos],THIRD)) % PERFECT_OCTAVE;
-    auto fifth  = (root + get_interval_from_root(qualities[currentPos],FIFTH)) % PERFECT_OCTAVE;
-
-    /// if the third is a tonal note, then double it
-    set<int> tonalNotes = tonality->get_tonal_notes();
-    if(tonalNotes.find(third) != tonalNotes.end()) { /// double the third and other notes should be present at least once
-        count(home, currentChord, IntSet(get_all_given_note(third)), IRT_EQ, 2);
-    }
-    else if((degrees[currentPos] == SEVENTH_DEGREE && qualities[currentPos] == DIMINISHED_CHORD) ||
-        degrees[currentPos] == FLAT_TWO) {
-        /// double the third and other notes should be present at least once
-        count(home, currentChord, IntSet(get_all_given_note(third)), IRT_EQ, 2);
-    }
-    /// Dominant diminished seventh chords (aka minor ninth dominant chords without the root)
-    else if ((degrees[currentPos] == FIFTH_DEGREE || (degrees[currentPos] >= FIVE_OF_TWO && degrees[currentPos] <= FIVE_OF_SEVEN))
-        && qualities[currentPos] == DIMINISHED_SEVENTH_CHORD) {
-
-        auto root_dim       = (root + MINOR_THIRD) % PERFECT_OCTAVE;
-        auto third_dim      = (root_dim + MINOR_THIRD) % PERFECT_OCTAVE;
-        auto fifth_dim      = (third_dim + MINOR_THIRD) % PERFECT_OCTAVE;
-        auto seventh_dim    = (fifth_dim + MINOR_THIRD) % PERFECT_OCTAVE;
-
-        count(home, currentChord, IntSet(get_all_given_note(root_dim)),     IRT_EQ, 1);
-        count(home, currentChord, IntSet(get_all_given_note(third_dim)),    IRT_EQ, 1);
-        count(home, currentChord, IntSet(get_all_given_note(fifth_dim)),    IRT_EQ, 1);
-        count(home, currentChord, IntSet(get_all_given_note(seventh_dim)),  IRT_EQ, 1);
-        }
-    else{ /// default case: double the fundamental or the fifth of the chord unless the top and bottom voices move down and up respectively
-        if(currentPos < size-1 && currentPos > 0){ /// this special case cannot happen on the first and last chord
-            ///BoolVar to see if the bass rises for the first motion
-            BoolVar bassRises1 = expr(home, expr(home,bassMelodicIntervals[currentPos-1] > 0) &&
-                expr(home, bassMelodicIntervals[currentPos-1] <= 2));
-            /// BoolVar to see if the bass rises for the second motion
-            BoolVar bassRises2 = expr(home, expr(home, bassMelodicIntervals[currentPos] > 0) &&
-                expr(home, bassMelodicIntervals[currentPos] <= 2));
-
-            /// BoolVar to see if the bass rises overall
-            BoolVar bassRisesOverall = expr(home, bassRises1 && bassRises2);
-
-            /// BoolVar to see if the soprano falls for the first motion
-            BoolVar sopranoFalls1 = expr(home, expr(home, sopranoMelodicIntervals[currentPos-1] < 0) &&
-                expr(home, sopranoMelodicIntervals[currentPos-1] >= -2));
-            /// BoolVar to see if the soprano falls for the second motion
-            BoolVar sopranoFalls2 = expr(home, expr(home, sopranoMelodicIntervals[currentPos] < 0) &&
-                expr(home, sopranoMelodicIntervals[currentPos] >= -2));
-
-            /// BoolVar to see if the soprano falls overall
-            BoolVar sopranoFallsOverall = expr(home, sopranoFalls1 && sopranoFalls2);
-
-            /// BoolVar to see if the voices move step wise by contrary motion over the three chords
-            BoolVar contraryMotion = expr(home, bassRisesOverall && sopranoFallsOverall);
-
-            IntVar nOfBassNotes(home,0,nVoices);
-            count(home, currentChord, IntSet(get_all_given_note(third)), IRT_EQ,nOfBassNotes);
-            rel(home, contraryMotion, BOT_EQV, expr(home, nOfBassNotes == 2), true);
-            rel(home, expr(home, !contraryMotion), BOT_EQV, expr(home, nOfBassNotes == 1), true);
-        }
-        else{ /// the bass can't be doubled
-            count(home, currentChord, IntSet(get_all_given_note(root)), IRT_EQ, 1);
-        }
-    }
-    /// each note always has to be present at least once
-    if (qualities[currentPos] != MINOR_NINTH_DOMINANT_CHORD) {
-        count(home, currentChord, IntSet(get_all_given_note(root)), IRT_GQ, 1);
-    }
-    count(home, currentChord, IntSet(get_all_given_note(third)), IRT_GQ, 1);
-    count(home, currentChord, IntSet(get_all_given_note(fifth)), IRT_GQ, 1);
-    if(qualities[currentPos] >= DOMINANT_SEVENTH_CHORD){
-        auto seventh = (root + get_interval_from_root(qualities[currentPos],SEVENTH)) % PERFECT_OCTAVE;
-        count(home, currentChord, IntSet(get_all_given_note(seventh)), IRT_GQ, 1);
-    }
-
+void double_third_on_contrary_motion(Home home, RuleLiterals &literals, int nVoices, int currentPos, int third,
+                                     const IntVarArgs &currentChord, const IntVarArgs &bassMelodicIntervals,
+                                     const IntVarArgs &sopranoMelodicIntervals) {
+    /// the voices move step wise by contrary motion over the three chords if the bass rises by step and the soprano
+    /// falls by step for both motions
+    BoolVar contraryMotion(home, 0, 1);
+    rel(home, BOT_AND, BoolVarArgs({
+        literals.condition(bassMelodicIntervals[currentPos-1], 1, MAJOR_SECOND),
+        literals.condition(bassMelodicIntervals[currentPos], 1, MAJOR_SECOND),
+        literals.condition(sopranoMelodicIntervals[currentPos-1], -MAJOR_SECOND, -1),
+        literals.condition(sopranoMelodicIntervals[currentPos], -MAJOR_SECOND, -1)}), contraryMotion);
+
+    /// the third is doubled if and only if there is contrary motion, otherwise it is present once
+    IntVar nOfBassNotes(home,0,nVoices);
+    count(home, currentChord, IntSet(get_all_given_note(third)), IRT_EQ,nOfBassNotes);
+    literals.equivalent(contraryMotion, nOfBassNotes, IRT_EQ, 2);
+    literals.equivalent(contraryMotion, nOfBassNotes, IRT_NQ, 1);
 }
-
-/**
- * Sets the number of times each note of the chord is present in the chord
- * @param home the instance of the problem
- * @param size the size of the chord progression
- * @param nVoices the number of voices
- * @param currentPos the current position in the chord progression
- * @param tonality the tonality of the piece
- * @param degrees the degree of the chord
- * @param qualities the qualities of the chords
- * @param currentChord the array containing a chord in the form [bass, alto, tenor, soprano]
- */
-void chord_note_occurrence_second_inversion(const Home& home, int size, int nVoices, int currentPos, Tonality *tonality,
-                                            vector<int> degrees, vector<int> qualities, const IntVarArgs &currentChord){
-    auto root = tonality->get_degree_note(degrees[currentPos]);
-    auto third = (root + get_interval_from_root(qualities[currentPos],THIRD)) % PERFECT_OCTAVE;
-    auto fifth = (root + get_interval_from_root(qualities[currentPos],FIFTH)) % PERFECT_OCTAVE;
-
-    if(degrees[currentPos] == SEVENTH_DEGREE && qualities[currentPos] == DIMINISHED_CHORD) {
-        count(home, currentChord, IntSet(get_all_given_note(root)), IRT_EQ, 1);
-        count(home, currentChord, IntSet(get_all_given_note(third)), IRT_EQ, 2);
-        count(home, currentChord, IntSet(get_all_given_note(fifth)), IRT_EQ, 1);
-    }
-    else{ /// default case: if the root or third of the chord are in the chord before, they can be doubled if it is in
-        /// the chord before at the same height. The bass (fifth) can always be doubled -> @todo
-        count(home, currentChord, IntSet(get_all_given_note(root)), IRT_EQ, 1);
-        count(home, currentChord, IntSet(get_all_given_note(third)), IRT_EQ, 1);
-        count(home, currentChord, IntSet(get_all_given_note(fifth)), IRT_GQ, 1);
-        if(qualities[currentPos] >= DOMINANT_SEVENTH_CHORD){
-            auto seventh = (root + get_interval_from_root(qualities[currentPos],SEVENTH)) % PERFECT_OCTAVE;
-            count(home, currentChord, IntSet(get_all_given_note(seventh)), IRT_EQ, 1);
-        }
-    }
-}
-
-/**
- * Sets the number of times each note of the chord is present in the chord
- * @param home the instance of the problem
- * @param size the size of the chord progression
- * @param nVoices the number of voices
- * @param currentPos the current position in the chord progression
- * @param tonality the tonality of the piece
- * @param degrees the degree of the chord
- * @param qualities the qualities of the chords
- * @param currentChord the array containing a chord in the form [bass, alto, tenor, soprano]
- */
-void chord_note_occurrence_third_inversion(const Home& home, int size, int nVoices, int currentPos, Tonality *tonality,
-                                           vector<int> degrees, vector<int> qualities, const IntVarArgs &currentChord) {
-    if (qualities[currentPos] < DOMINANT_SEVENTH_CHORD) {
-        throw std::invalid_argument("The chord cannot be in third inversion");
-    }
-    auto root   = tonality->get_degree_note(degrees[currentPos]);
-    auto third  = (root + get_interval_from_root(qualities[currentPos],THIRD)) % PERFECT_OCTAVE;
-    auto fifth  = (root + get_interval_from_root(qualities[currentPos],FIFTH)) % PERFECT_OCTAVE;
-
-    count(home, currentChord, IntSet(get_all_given_note(root)),     IRT_EQ, 1);
-    count(home, currentChord, IntSet(get_all_given_note(third)),    IRT_EQ, 1);
-    count(home, currentChord, IntSet(get_all_given_note(fifth)),    IRT_GQ, 1);
-    if(qualities[currentPos] >= DOMINANT_SEVENTH_CHORD){
-        auto seventh = (root + get_interval_from_root(qualities[currentPos],SEVENTH)) % PERFECT_OCTAVE;
-        count(home, currentChord, IntSet(get_all_given_note(seventh)), IRT_EQ, 1);
-    }
-}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "../../headers/diatony/ParallelIntervalsPropagator.hpp"
+
+namespace {
+    /**
+     * Returns the interval between two notes regardless of the octave
+     * @param lower the lower note
+     * @param upper the upper note
+     * @return the interval in [0,11]
+     */
+    int pitch_class_interval(const int lower, const int upper) {
+        return ((upper - lower) % PERFECT_OCTAVE + PERFECT_OCTAVE) % PERFECT_OCTAVE;
+    }
+
+    /**
+     * Propagator forbidding parallel intervals between two consecutive chords. The views are the notes of the two
+     * chords [bass0, tenor0, alto0, soprano0, bass1, tenor1, alto1, soprano1]. It subscribes to the assignment of the
+     * views only, as nothing can be deduced on a voice pair before three of its four notes are known.
+     */
+    class ParallelIntervals : public NaryPropagator<Int::IntView, Int::PC_INT_VAL> {
+    protected:
+        using NaryPropagator<Int::IntView, Int::PC_INT_VAL>::x;
+        int forbidden;      // the forbidden intervals as a bit mask over [0,11]
+
+        /// Constructor for posting
+        ParallelIntervals(Home home, ViewArray<Int::IntView>& x, const int forbidden)
+            : NaryPropagator<Int::IntView, Int::PC_INT_VAL>(home, x), forbidden(forbidden) {}
+
+        /// Constructor for cloning
+        ParallelIntervals(Space& home, ParallelIntervals& p)
+            : NaryPropagator<Int::IntView, Int::PC_INT_VAL>(home, p), forbidden(p.forbidden) {}
+
+        /**
+         * Filters one voice pair in one direction: if both notes of the pair are known in chord a and form a forbidden
+         * interval, the pair cannot form the same interval in chord b, unless neither voice moves.
+         * @param home the space
+         * @param a the first chord (0 or 1)
+         * @param lower the lower voice
+         * @param upper the upper voice
+         * @param modified set to true if a domain was modified
+         * @return ES_FAILED if the constraint is violated, ES_OK otherwise
+         */
+        ExecStatus filter_pair(Space& home, const int a, const int lower, const int upper, bool& modified) {
+            Int::IntView& aLower = x[a * 4 + lower];
+            Int::IntView& aUpper = x[a * 4 + upper];
+            Int::IntView& bLower = x[(1 - a) * 4 + lower];
+            Int::IntView& bUpper = x[(1 - a) * 4 + upper];
+            if (!aLower.assigned() || !aUpper.assigned())
+                return ES_OK;
+            const int interval = pitch_class_interval(aLower.val(), aUpper.val());
+            if ((forbidden >> interval & 1) == 0)
+                return ES_OK;
+
+            if (bLower.assigned() && bUpper.assigned()) {
+                const bool parallel = pitch_class_interval(bLower.val(), bUpper.val()) == interval &&
+                    !(bLower.val() == aLower.val() && bUpper.val() == aUpper.val());
+                return parallel ? ES_FAILED : ES_OK;
+            }
+            if (bLower.assigned() || bUpper.assigned()) {
+                /// the known note of chord b fixes the only notes of the other voice that form the interval
+                const bool lowerKnown = bLower.assigned();
+                Int::IntView& free = lowerKnown ? bUpper : bLower;
+                const int known = lowerKnown ? bLower.val() : bUpper.val();
+                /// the pair may keep the same notes if the known voice did not move
+                const int allowed = lowerKnown ? (known == aLower.val() ? aUpper.val() : -1)
+                                               : (known == aUpper.val() ? aLower.val() : -1);
+                vector<int> removed;
+                for (Int::ViewValues<Int::IntView> v(free); v(); ++v) {
+                    const int interval2 = lowerKnown ? pitch_class_interval(known, v.val())
+                                                     : pitch_class_interval(v.val(), known);
+                    if (interval2 == interval && v.val() != allowed)
+                        removed.push_back(v.val());
+                }
+                for (const int v : removed)
+                    GECODE_ME_CHECK(free.nq(home, v));
+                modified = modified || !removed.empty();
+            }
+            return ES_OK;
+        }
+
+    public:
+        /**
+         * Posts the propagator
+         * @param home the space
+         * @param x the notes of the two chords
+         * @param forbidden the forbidden intervals as a bit mask over [0,11]
+         * @return the status of the posting
+         */
+        static ExecStatus post(Home home, ViewArray<Int::IntView>& x, const int forbidden) {
+            (void) new (home) ParallelIntervals(home, x, forbidden);
+            return ES_OK;
+        }
+
+        Propagator* copy(Space& home) override {
+            return new (home) ParallelIntervals(home, *this);
+        }
+
+        PropCost cost(const Space&, const ModEventDelta&) const override {
+            return PropCost::linear(PropCost::LO, x.size());
+        }
+
+        ExecStatus propagate(Space& home, const ModEventDelta&) override {
+            /// filtering can fix a note, which can enable more filtering on other pairs
+            bool modified = true;
+            while (modified) {
+                modified = false;
+                for (int lower = BASS; lower < SOPRANO; lower++) {
+                    for (int upper = lower + 1; upper <= SOPRANO; upper++) {
+                        GECODE_ES_CHECK(filter_pair(home, 0, lower, upper, modified));
+                        GECODE_ES_CHECK(filter_pair(home, 1, lower, upper, modified));
+                    }
+                }
+            }
+            for (int i = 0; i < x.size(); i++)
+                if (!x[i].assigned())
+                    return ES_FIX;
+            return home.ES_SUBSUMED(*this);
+        }
+    };
+}
+
+/**
+ * Forbids parallel intervals between every pair of voices of two consecutive chords, using a single dedicated
+ * propagator. Two voices move in parallel if they form the same forbidden interval (regardless of the octave) in both
+ * chords, unless neither voice moves. The propagator only wakes up when a note is fixed, and then removes from the
+ * other voices the notes that would create a parallel interval.
+ * @param home the instance of the problem
+ * @param currentChord the notes of the first chord [bass, tenor, alto, soprano]
+ * @param nextChord the notes of the second chord [bass, tenor, alto, soprano]
+ * @param intervals the list of intervals to forbid. They are taken modulo an octave, so that octaves and unisons are
+ * the same interval.
+ */
+void no_parallel_intervals(Home home, const IntVarArgs& currentChord, const IntVarArgs& nextChord,
+                           const vector<int>& intervals) {
+    if (currentChord.size() != 4 || nextChord.size() != 4)
+        throw std::invalid_argument("no_parallel_intervals expects two chords of 4 notes");
+    GECODE_POST;
+    int forbidden = 0;
+    for (const int interval : intervals)
+        forbidden |= 1 << (interval % PERFECT_OCTAVE);
+    IntVarArgs notes(currentChord);
+    notes << nextChord;
+    ViewArray<Int::IntView> x(home, notes);
+    GECODE_ES_FAIL(ParallelIntervals::post(home, x, forbidden));
+}
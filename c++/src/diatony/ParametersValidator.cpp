@@ -0,0 +1,323 @@
+#include <tuple>
+
+#include "../../headers/diatony/ParametersValidator.hpp"
+
+namespace {
+    /// the mask of the 12 pitch classes
+    constexpr int ALL_PITCH_CLASSES = (1 << PERFECT_OCTAVE) - 1;
+
+    /**
+     * Returns the mask of a single pitch class
+     * @param note a note, possibly negative
+     * @return the mask with the bit of the pitch class of the note set
+     */
+    int pitch_class_bit(const int note) {
+        return 1 << ((note % PERFECT_OCTAVE + PERFECT_OCTAVE) % PERFECT_OCTAVE);
+    }
+
+    /**
+     * Returns the notes that every legal voicing of a chord contains: its bass, its third and its seventh, except in
+     * the fundamental state chords for which ChainModel::respects_note_occurrences does not require the seventh.
+     * @param tonality the tonality of the chord
+     * @param degree the degree of the chord
+     * @param quality the quality of the chord
+     * @param state the state of the chord
+     * @return the mask of the pitch classes present in every voicing of the chord
+     */
+    int required_pitch_classes(const Tonality* tonality, const int degree, const int quality, const int state) {
+        const int root = tonality->get_degree_note(degree);
+        int required = pitch_class_bit(root + get_interval_from_root(quality, state)) |
+            pitch_class_bit(root + get_interval_from_root(quality, THIRD));
+        const bool optionalSeventh = state == FUNDAMENTAL_STATE &&
+            (degree == FLAT_TWO || degree == AUGMENTED_SIXTH || degree == SIXTH_DEGREE);
+        if (quality >= DOMINANT_SEVENTH_CHORD && !optionalSeventh)
+            required |= pitch_class_bit(root + get_interval_from_root(quality, SEVENTH));
+        return required;
+    }
+
+    /**
+     * Returns whether a note can move by a melodic interval in [lowest, highest] to a note of the next chord
+     * @param note the note of the current chord
+     * @param nextNotes the mask of the pitch classes of the next chord
+     * @param lowest the lowest melodic interval allowed
+     * @param highest the highest melodic interval allowed
+     * @return true if one of the allowed intervals leads to a note of the next chord
+     */
+    bool can_move_to(const int note, const int nextNotes, const int lowest, const int highest) {
+        for (int interval = lowest; interval <= highest; interval++)
+            if ((nextNotes & pitch_class_bit(note + interval)) != 0)
+                return true;
+        return false;
+    }
+
+    /**
+     * Returns the prefix of the messages about a chord
+     * @param section the section of the chord
+     * @param position the absolute position of the chord
+     * @return the prefix of the message
+     */
+    string chord_message(const int section, const int position) {
+        return "Section " + std::to_string(section) + ", chord " + std::to_string(position) + ": ";
+    }
+
+    /**
+     * Checks the parameters of a section and of its chords
+     * @param section the index of the section
+     * @param sectionParams the parameters of the section
+     * @param nChords the number of chords in the piece
+     * @param errors the vector to which the problems are added
+     */
+    void check_section(const int section, const TonalProgressionParameters* sectionParams, const int nChords,
+                       vector<string>& errors) {
+        const string prefix = "Section " + std::to_string(section) + ": ";
+        if (sectionParams == nullptr) {
+            errors.push_back(prefix + "the parameters are missing");
+            return;
+        }
+        const int size = sectionParams->get_size();
+        const int start = sectionParams->get_start();
+        const int end = sectionParams->get_end();
+        if (sectionParams->get_tonality() == nullptr)
+            errors.push_back(prefix + "the tonality is missing");
+        if (size < 1)
+            errors.push_back(prefix + "the section must have at least one chord, got " + std::to_string(size));
+        if (size != end - start + 1)
+            errors.push_back(prefix + "the length (" + std::to_string(size) + ") is not coherent with the start (" +
+                std::to_string(start) + ") and end (" + std::to_string(end) + ") positions");
+        if (start < 0 || end >= nChords)
+            errors.push_back(prefix + "the positions [" + std::to_string(start) + ", " + std::to_string(end) +
+                "] are outside of the piece [0, " + std::to_string(nChords - 1) + "]");
+
+        const vector<int>& degrees = sectionParams->get_chordDegrees();
+        const vector<int>& qualities = sectionParams->get_chordQualities();
+        const vector<int>& states = sectionParams->get_chordStates();
+        const int nDegrees = static_cast<int>(degrees.size());
+        const int nQualities = static_cast<int>(qualities.size());
+        const int nStates = static_cast<int>(states.size());
+        if (nDegrees != size || nQualities != size || nStates != size) {
+            errors.push_back(prefix + "expected " + std::to_string(size) + " degrees, qualities and states, got " +
+                std::to_string(nDegrees) + ", " + std::to_string(nQualities) + " and " + std::to_string(nStates));
+            return;
+        }
+        for (int i = 0; i < size; i++) {
+            if (degrees[i] < 0 || degrees[i] >= N_DEGREES)
+                errors.push_back(chord_message(section, start + i) + "unknown degree " + std::to_string(degrees[i]));
+            if (qualities[i] < 0 || qualities[i] >= N_CHORD_QUALITIES)
+                errors.push_back(chord_message(section, start + i) + "unknown quality " +
+                    std::to_string(qualities[i]));
+            else if (states[i] < FUNDAMENTAL_STATE || states[i] >= get_number_of_notes_in_chord(qualities[i]))
+                errors.push_back(chord_message(section, start + i) + "a " + chordQualityNames[qualities[i]] +
+                    " chord cannot be in state " + std::to_string(states[i]));
+        }
+    }
+
+    /**
+     * Checks the parameters of a modulation
+     * @param modulation the index of the modulation
+     * @param modulationParams the parameters of the modulation
+     * @param nChords the number of chords in the piece
+     * @param errors the vector to which the problems are added
+     */
+    void check_modulation(const int modulation, const ModulationParameters* modulationParams, const int nChords,
+                          vector<string>& errors) {
+        const string prefix = "Modulation " + std::to_string(modulation) + ": ";
+        if (modulationParams == nullptr) {
+            errors.push_back(prefix + "the parameters are missing");
+            return;
+        }
+        const int type = modulationParams->get_type();
+        const int start = modulationParams->get_start();
+        const int end = modulationParams->get_end();
+        if (type < PERFECT_CADENCE_MODULATION || type > CHROMATIC_MODULATION)
+            errors.push_back(prefix + "unknown modulation type " + std::to_string(type));
+        if (modulationParams->get_from() == nullptr || modulationParams->get_to() == nullptr)
+            errors.push_back(prefix + "the parameters of the sections are missing");
+        else if (modulationParams->get_to()->get_tonality() == nullptr)
+            errors.push_back(prefix + "the tonality of the new section is missing");
+        if (start < 0 || start > end || end >= nChords)
+            errors.push_back(prefix + "the positions [" + std::to_string(start) + ", " + std::to_string(end) +
+                "] are not an interval of the piece [0, " + std::to_string(nChords - 1) + "]");
+        /// the chromatic modulation relates the chord at its start to the next one
+        if (type == CHROMATIC_MODULATION && start + 1 >= nChords)
+            errors.push_back(prefix + "a chromatic modulation cannot start on the last chord");
+    }
+
+    /**
+     * Checks the rules between two consecutive chords of a section that can be decided from their pitch classes only.
+     * The rules are selected with the same conditions as in TonalProgression.
+     * @param section the index of the section
+     * @param sectionParams the parameters of the section
+     * @param allowed the pitch classes each chord of the piece can contain
+     * @param required the pitch classes each chord of the piece must contain
+     * @param errors the vector to which the problems are added
+     */
+    void check_transitions(const int section, const TonalProgressionParameters* sectionParams,
+                           const vector<int>& allowed, const vector<int>& required, vector<string>& errors) {
+        const ProgressionView progression = sectionParams->get_view();
+        const Tonality* tonality = progression.tonality;
+        const int start = sectionParams->get_start();
+        const int tonic = tonality->get_tonic();
+
+        for (int i = 0; i < progression.size() - 1; i++) {
+            const int degree = progression.degrees[i], nextDegree = progression.degrees[i + 1];
+            const int quality = progression.qualities[i], nextQuality = progression.qualities[i + 1];
+            const int state = progression.states[i], nextState = progression.states[i + 1];
+            const int current = start + i;
+            const int nextNotes = allowed[current + 1];
+
+            /// tritone resolution (see tritone_resolution)
+            if ((degree == SEVENTH_DEGREE && quality == DIMINISHED_CHORD && nextDegree == FIRST_DEGREE)
+                || (degree == FIFTH_DEGREE && nextDegree == FIRST_DEGREE)
+                || ((degree >= FIVE_OF_TWO && degree <= FIVE_OF_SEVEN) && nextDegree != FIFTH_DEGREE_APPOGIATURA)) {
+                vector<std::tuple<int, int, int>> resolutions; /// (note, lowest interval, highest interval)
+                if (degree == FIFTH_DEGREE || degree == SEVENTH_DEGREE) {
+                    const bool fourthRises = (degree == SEVENTH_DEGREE && state == FIRST_INVERSION &&
+                        nextDegree == FIRST_DEGREE && nextState == FIRST_INVERSION) ||
+                        (degree == FIFTH_DEGREE && quality == DOMINANT_SEVENTH_CHORD && state == SECOND_INVERSION &&
+                        nextDegree == FIRST_DEGREE && nextState == FIRST_INVERSION);
+                    resolutions.emplace_back(tonic + PERFECT_FOURTH, fourthRises ? 1 : -MAJOR_SECOND,
+                        fourthRises ? MAJOR_SECOND : -1);
+                    resolutions.emplace_back(tonic + MAJOR_SEVENTH, MINOR_SECOND, MINOR_SECOND);
+                }
+                else {
+                    const int root = tonality->get_degree_note(degree);
+                    resolutions.emplace_back(root + MAJOR_THIRD, MINOR_SECOND, MINOR_SECOND);
+                    resolutions.emplace_back(root + MINOR_SEVENTH, -MAJOR_SECOND, -1);
+                }
+                for (const auto& resolution : resolutions) {
+                    const int note = std::get<0>(resolution);
+                    if ((required[current] & pitch_class_bit(note)) != 0 &&
+                        !can_move_to(note, nextNotes, std::get<1>(resolution), std::get<2>(resolution)))
+                        errors.push_back(chord_message(section, current) + "the " +
+                            midi_to_letter(note % PERFECT_OCTAVE) + " of " + degreeNames[degree] +
+                            " cannot be resolved on " + degreeNames[nextDegree]);
+                }
+            }
+
+            /// species seventh chords, unless a special rule applies to the transition (see TonalProgression)
+            const bool specialRule = (degree == FIFTH_DEGREE && state == FUNDAMENTAL_STATE &&
+                nextDegree == SIXTH_DEGREE && nextState == FUNDAMENTAL_STATE) || degree == AUGMENTED_SIXTH ||
+                (degree == FIRST_DEGREE && state == SECOND_INVERSION && nextDegree == FIFTH_DEGREE &&
+                (quality == MAJOR_CHORD || quality == DOMINANT_SEVENTH_CHORD));
+            if (!specialRule &&
+                (nextQuality == MAJOR_SEVENTH_CHORD || nextQuality == MINOR_SEVENTH_CHORD ||
+                nextQuality == DIMINISHED_SEVENTH_CHORD || nextQuality == HALF_DIMINISHED_CHORD)
+                && nextQuality <= SEVENTH_DEGREE) {
+                /// the seventh is played by the same voices in both chords
+                const int seventh = pitch_class_bit(tonality->get_degree_note(nextDegree) +
+                    get_interval_from_root(nextQuality, SEVENTH));
+                if ((required[current + 1] & seventh) != 0 && (allowed[current] & seventh) == 0)
+                    errors.push_back(chord_message(section, current + 1) + "the seventh of " +
+                        degreeNames[nextDegree] + " cannot be prepared by " + degreeNames[degree]);
+            }
+        }
+    }
+}
+
+/**
+ * Checks the parameters of a four voice texture problem without building the model (see the header for the list of
+ * the checks)
+ * @param params the parameters of the problem
+ * @return a message for each problem found, empty if the parameters are valid
+ */
+vector<string> validate_parameters(const FourVoiceTextureParameters* params) {
+    vector<string> errors;
+    if (params == nullptr) {
+        errors.emplace_back("The parameters are missing");
+        return errors;
+    }
+    const int nChords = params->get_totalNumberOfChords();
+    const int nSections = params->get_numberOfSections();
+    const vector<TonalProgressionParameters*> sections = params->get_sectionParameters();
+
+    /// structure of the piece
+    if (nChords < 1)
+        errors.push_back("The piece must have at least one chord, got " + std::to_string(nChords));
+    const int nSectionParams = static_cast<int>(sections.size());
+    if (nSections < 1 || nSections != nSectionParams) {
+        errors.push_back("The piece has " + std::to_string(nSections) + " sections but " +
+            std::to_string(nSectionParams) + " section parameters");
+        return errors;
+    }
+    if (params->get_numberOfModulations() != nSections - 1) {
+        errors.push_back("The piece has " + std::to_string(nSections) + " sections but " +
+            std::to_string(params->get_numberOfModulations()) + " modulations, expected " +
+            std::to_string(nSections - 1));
+        return errors;
+    }
+    for (int s = 0; s < nSections; s++)
+        check_section(s, sections[s], nChords, errors);
+    for (int m = 0; m < nSections - 1; m++)
+        check_modulation(m, params->get_modulationParameters(m), nChords, errors);
+    if (!errors.empty())
+        return errors;
+
+    /// the sections follow each other, and only overlap on the pivot chord of a pivot chord modulation
+    if (sections.front()->get_start() != 0)
+        errors.push_back("Section 0 must start on the first chord, got " +
+            std::to_string(sections.front()->get_start()));
+    if (sections.back()->get_end() != nChords - 1)
+        errors.push_back("Section " + std::to_string(nSections - 1) + " must end on the last chord (" +
+            std::to_string(nChords - 1) + "), got " + std::to_string(sections.back()->get_end()));
+    for (int s = 0; s < nSections - 1; s++) {
+        const int type = params->get_modulationParameters(s)->get_type();
+        const int expectedStart = type == PIVOT_CHORD_MODULATION ? sections[s]->get_end() : sections[s]->get_end() + 1;
+        if (sections[s + 1]->get_start() != expectedStart)
+            errors.push_back("Section " + std::to_string(s + 1) + " must start on chord " +
+                std::to_string(expectedStart) + " after a " + modulation_type_names[type] + " modulation, got " +
+                std::to_string(sections[s + 1]->get_start()));
+    }
+    if (!errors.empty())
+        return errors;
+
+    /// the pitch classes each chord can and must contain, in all the sections it belongs to
+    vector<int> allowed(nChords, ALL_PITCH_CLASSES);
+    vector<int> required(nChords, 0);
+    for (const auto sectionParams : sections) {
+        const ProgressionView progression = sectionParams->get_view();
+        for (int i = 0; i < progression.size(); i++) {
+            const int position = sectionParams->get_start() + i;
+            allowed[position] &= get_chord_pitch_class_mask(
+                progression.tonality->get_degree_note(progression.degrees[i]), progression.qualities[i]);
+            required[position] |= required_pitch_classes(progression.tonality, progression.degrees[i],
+                progression.qualities[i], progression.states[i]);
+        }
+    }
+    for (int s = 0; s < nSections - 1; s++) {
+        const int pivot = sections[s + 1]->get_start();
+        if (pivot == sections[s]->get_end() && (required[pivot] & ~allowed[pivot]) != 0)
+            errors.push_back(chord_message(s + 1, pivot) + "the pivot chord is not the same chord in both tonalities");
+    }
+
+    /// transitions
+    for (int s = 0; s < nSections; s++)
+        check_transitions(s, sections[s], allowed, required, errors);
+    for (int m = 0; m < nSections - 1; m++) {
+        const ModulationParameters* modulation = params->get_modulationParameters(m);
+        if (modulation->get_type() != CHROMATIC_MODULATION)
+            continue;
+        /// the leading tone of the new tonality must be preceded by the note one semitone below it in the same voice
+        const int start = modulation->get_start();
+        const int leadingTone = modulation->get_to()->get_tonality()->get_degree_note(SEVENTH_DEGREE);
+        if ((required[start + 1] & pitch_class_bit(leadingTone)) != 0 &&
+            (allowed[start] & pitch_class_bit(leadingTone - MINOR_SECOND)) == 0)
+            errors.push_back("Modulation " + std::to_string(m) + ": the leading tone of the new tonality on chord " +
+                std::to_string(start + 1) + " cannot be approached chromatically from chord " + std::to_string(start));
+    }
+    return errors;
+}
+
+/**
+ * Checks the parameters of a four voice texture problem (see validate_parameters)
+ * @param params the parameters of the problem
+ * @throws std::invalid_argument listing the problems found, if any
+ */
+void check_parameters(const FourVoiceTextureParameters* params) {
+    const vector<string> errors = validate_parameters(params);
+    if (errors.empty())
+        return;
+    string message = "Invalid parameters:";
+    for (const auto& error : errors)
+        message += "\n" + error;
+    throw std::invalid_argument(message);
+}
@@ -0,0 +1,184 @@
+#include "../../headers/diatony/RulePosting.hpp"
+
+namespace {
+    /// relation value used in the keys of range literals
+    const int LITERAL_DOMAIN = -1;
+
+#ifdef DIATONY_FULL_REIFICATION
+    const ReifyMode PREMISE_MODE        = RM_EQV;
+    const ReifyMode CONSEQUENCE_MODE    = RM_EQV;
+#else
+    const ReifyMode PREMISE_MODE        = RM_PMI;
+    const ReifyMode CONSEQUENCE_MODE    = RM_IMP;
+#endif
+}
+
+/**
+ * Constructor
+ * @param home the space in which the rules are posted
+ */
+RuleLiterals::RuleLiterals(Home home) : home(home) {}
+
+/**
+ * Returns the literal with the given key, creating it if needed. If the literal exists but only one direction of
+ * the requested mode is posted, the missing direction is posted with the post function.
+ * @param key the key of the literal
+ * @param mode the reification mode needed by the caller
+ * @param post posts the reified constraint of the literal with the given Reify object
+ * @return the Boolean variable of the literal
+ */
+BoolVar RuleLiterals::literal(const LiteralKey& key, const ReifyMode mode,
+    const std::function<void(const Reify&)>& post) {
+    auto it = literals.find(key);
+    if (it == literals.end()) {
+        BoolVar b(home, 0, 1);
+        post(Reify(b, mode));
+        literals.insert(std::make_pair(key, Literal{b, mode}));
+        return b;
+    }
+    Literal& lit = it->second;
+    if (lit.mode != RM_EQV && lit.mode != mode) {
+        /// only post the direction that is missing
+        post(Reify(lit.var, lit.mode == RM_IMP ? RM_PMI : RM_IMP));
+        lit.mode = RM_EQV;
+    }
+    return lit.var;
+}
+
+/**
+ * Returns a literal that is true if x rel c holds ([x rel c] -> b). It can only be used as a premise.
+ * @param x the variable
+ * @param irt the relation
+ * @param c the constant
+ * @return the Boolean variable of the literal
+ */
+BoolVar RuleLiterals::premise(const IntVar& x, const IntRelType irt, const int c) {
+    Home h = home;
+    return literal(LiteralKey(x.varimp(), irt, nullptr, c, 0), PREMISE_MODE,
+        [h, x, irt, c](const Reify& r) { rel(h, x, irt, c, r); });
+}
+
+/**
+ * Returns a literal that is true if x rel y holds ([x rel y] -> b). It can only be used as a premise.
+ * @param x the first variable
+ * @param irt the relation
+ * @param y the second variable
+ * @return the Boolean variable of the literal
+ */
+BoolVar RuleLiterals::premise(const IntVar& x, const IntRelType irt, const IntVar& y) {
+    Home h = home;
+    return literal(LiteralKey(x.varimp(), irt, y.varimp(), 0, 0), PREMISE_MODE,
+        [h, x, irt, y](const Reify& r) { rel(h, x, irt, y, r); });
+}
+
+/**
+ * Returns a literal that forces x rel c when it is true (b -> [x rel c]). It can only be used as a consequence.
+ * @param x the variable
+ * @param irt the relation
+ * @param c the constant
+ * @return the Boolean variable of the literal
+ */
+BoolVar RuleLiterals::consequence(const IntVar& x, const IntRelType irt, const int c) {
+    Home h = home;
+    return literal(LiteralKey(x.varimp(), irt, nullptr, c, 0), CONSEQUENCE_MODE,
+        [h, x, irt, c](const Reify& r) { rel(h, x, irt, c, r); });
+}
+
+/**
+ * Returns a literal that is equivalent to x rel c (b <-> [x rel c])
+ * @param x the variable
+ * @param irt the relation
+ * @param c the constant
+ * @return the Boolean variable of the literal
+ */
+BoolVar RuleLiterals::condition(const IntVar& x, const IntRelType irt, const int c) {
+    Home h = home;
+    return literal(LiteralKey(x.varimp(), irt, nullptr, c, 0), RM_EQV,
+        [h, x, irt, c](const Reify& r) { rel(h, x, irt, c, r); });
+}
+
+/**
+ * Returns a literal that is equivalent to min <= x <= max (b <-> [x in min..max])
+ * @param x the variable
+ * @param min the lower bound of the range
+ * @param max the upper bound of the range
+ * @return the Boolean variable of the literal
+ */
+BoolVar RuleLiterals::condition(const IntVar& x, const int min, const int max) {
+    Home h = home;
+    return literal(LiteralKey(x.varimp(), LITERAL_DOMAIN, nullptr, min, max), RM_EQV,
+        [h, x, min, max](const Reify& r) { dom(h, x, min, max, r); });
+}
+
+/**
+ * Posts b -> x rel c with half reification
+ * @param b the premise
+ * @param x the variable
+ * @param irt the relation
+ * @param c the constant
+ */
+void RuleLiterals::implies(const BoolVar& b, const IntVar& x, const IntRelType irt, const int c) {
+#ifdef DIATONY_FULL_REIFICATION
+    rel(home, b, BOT_IMP, condition(x, irt, c), 1);
+#else
+    rel(home, x, irt, c, Reify(b, RM_IMP));
+#endif
+}
+
+/**
+ * Posts b -> min <= x <= max with a single half reified domain constraint
+ * @param b the premise
+ * @param x the variable
+ * @param min the lower bound of the range
+ * @param max the upper bound of the range
+ */
+void RuleLiterals::implies(const BoolVar& b, const IntVar& x, const int min, const int max) {
+#ifdef DIATONY_FULL_REIFICATION
+    rel(home, b, BOT_IMP, condition(x, min, max), 1);
+#else
+    dom(home, x, min, max, Reify(b, RM_IMP));
+#endif
+}
+
+/**
+ * Posts b -> x in values with a single half reified domain constraint
+ * @param b the premise
+ * @param x the variable
+ * @param values the values allowed for x when b is true
+ */
+void RuleLiterals::implies(const BoolVar& b, const IntVar& x, const IntSet& values) {
+#ifdef DIATONY_FULL_REIFICATION
+    BoolVar inValues(home, 0, 1);
+    dom(home, x, values, Reify(inValues, RM_EQV));
+    rel(home, b, BOT_IMP, inValues, 1);
+#else
+    dom(home, x, values, Reify(b, RM_IMP));
+#endif
+}
+
+/**
+ * Posts (premises[0] && premises[1] && ...) -> x rel c as a clause on the premises and a consequence literal
+ * @param premises the premises of the rule
+ * @param x the variable
+ * @param irt the relation
+ * @param c the constant
+ */
+void RuleLiterals::implies_all(const BoolVarArgs& premises, const IntVar& x, const IntRelType irt, const int c) {
+    /// consequence || !premises[0] || !premises[1] || ...
+    clause(home, BOT_OR, BoolVarArgs({consequence(x, irt, c)}), premises, 1);
+}
+
+/**
+ * Posts b <-> x rel c. b is used directly as the reification variable, so no auxiliary literal is created.
+ * @param b the condition
+ * @param x the variable
+ * @param irt the relation
+ * @param c the constant
+ */
+void RuleLiterals::equivalent(const BoolVar& b, const IntVar& x, const IntRelType irt, const int c) {
+#ifdef DIATONY_FULL_REIFICATION
+    rel(home, b, BOT_EQV, condition(x, irt, c), 1);
+#else
+    rel(home, x, irt, c, Reify(b, RM_EQV));
+#endif
+}
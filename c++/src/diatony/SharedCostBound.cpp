@@ -0,0 +1,28 @@
+#include "../../headers/diatony/SharedCostBound.hpp"
+
+/**
+ * Publishes the cost vector of a new solution.
+ * @param costs the cost vector of a solution, in lexicographical order
+ * @return true if the cost vector is strictly better than the best one known so far, false otherwise
+ */
+bool SharedCostBound::update(const vector<int>& costs) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!bestCosts.empty() && !std::lexicographical_compare(costs.begin(), costs.end(),
+                                                            bestCosts.begin(), bestCosts.end()))
+        return false;
+    bestCosts = costs;
+    return true;
+}
+
+/**
+ * Gets the best cost vector found so far.
+ * @param costs the vector in which the best cost vector is written
+ * @return true if a solution has been published, false otherwise (costs is then left untouched)
+ */
+bool SharedCostBound::get(vector<int>& costs) const {
+    std::lock_guard<std::mutex> guard(lock);
+    if (bestCosts.empty())
+        return false;
+    costs = bestCosts;
+    return true;
+}
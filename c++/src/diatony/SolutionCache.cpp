@@ -0,0 +1,56 @@
+#include "../../headers/diatony/SolutionCache.hpp"
+
+/**
+ * Looks for the solution of a problem found with at least a given time limit
+ * @param problem the key of the problem
+ * @param timeLimit the time limit of the search that needs the solution
+ * @param voicing filled with the notes of the solution if one is found
+ * @param costs filled with the costs of the solution if one is found
+ * @return true if a solution was found
+ */
+bool SolutionCache::find(const string& problem, const double timeLimit, vector<int>& voicing, vector<int>& costs) {
+    std::lock_guard<std::mutex> guard(lock);
+    const auto entry = index.find(problem);
+    if (entry == index.end() || entry->second->timeLimit < timeLimit)
+        return false;
+    entries.splice(entries.begin(), entries, entry->second);
+    voicing = entry->second->voicing;
+    costs = entry->second->costs;
+    return true;
+}
+
+/**
+ * Keeps the solution of a problem, unless a solution found with a longer time limit is already kept. The least recently
+ * used solution is forgotten if the cache is full.
+ * @param problem the key of the problem
+ * @param timeLimit the time limit under which the solution was found
+ * @param voicing the notes of the solution
+ * @param costs the costs of the solution
+ */
+void SolutionCache::insert(const string& problem, const double timeLimit, const vector<int>& voicing,
+                           const vector<int>& costs) {
+    if (capacity == 0)
+        return;
+    std::lock_guard<std::mutex> guard(lock);
+    const auto entry = index.find(problem);
+    if (entry != index.end()) {
+        if (entry->second->timeLimit > timeLimit)
+            return;
+        entries.erase(entry->second);
+        index.erase(entry);
+    }
+    entries.push_front({problem, voicing, costs, timeLimit});
+    index[problem] = entries.begin();
+    if (entries.size() > capacity) {
+        index.erase(entries.back().problem);
+        entries.pop_back();
+    }
+}
+
+/**
+ * @return the number of solutions kept
+ */
+size_t SolutionCache::size() {
+    std::lock_guard<std::mutex> guard(lock);
+    return entries.size();
+}
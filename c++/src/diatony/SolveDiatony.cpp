@@ -3,48 +3,274 @@
 //
 
 #include <utility>
+#include <mutex>
+#include <thread>
 
 #include "../../headers/diatony/SolveDiatony.hpp"
+#include "../../headers/diatony/ChainSolver.hpp"
+#include "../../headers/diatony/ParametersValidator.hpp"
+
+namespace {
+    /** Restart policies used by the restart-based engines */
+    enum restart_policies {
+        LINEAR_GEOMETRIC_RESTARTS,  //0, the default policy of solve_diatony
+        LUBY_RESTARTS,              //1
+        GEOMETRIC_RESTARTS          //2
+    };
+
+    /// The number of states kept for each chord by the beam search warm starting solve_diatony
+    constexpr int WARM_START_BEAM_WIDTH = 16;
+
+    /// Under this time limit (in milliseconds), solve_diatony returns its warm start without searching
+    constexpr double WARM_START_ONLY_TIME_LIMIT = 10;
+
+    /**
+     * A configuration of a worker in the portfolio
+     */
+    struct PortfolioAsset {
+        int variableSelection;      // see variable_selection_heuristics
+        int valueSelection;         // see value_selection_heuristics
+        int restartPolicy;          // see restart_policies
+    };
+
+    /// The configurations of the portfolio workers. Worker i uses asset i % size with seed i+1, so that workers sharing
+    /// an asset still explore different parts of the search space.
+    const vector<PortfolioAsset> portfolioAssets = {
+        {RIGHT_TO_LEFT, VAL_RND, LINEAR_GEOMETRIC_RESTARTS},   // same strategy as solve_diatony
+        {RIGHT_TO_LEFT, VAL_RND, LUBY_RESTARTS},
+        {LEFT_TO_RIGHT, VAL_RND, LINEAR_GEOMETRIC_RESTARTS},
+        {DOM_SIZE_MIN,  VAL_RND, LUBY_RESTARTS},
+        {RIGHT_TO_LEFT, VAL_MED, GEOMETRIC_RESTARTS},
+        {DEGREE_MAX,    VAL_RND, GEOMETRIC_RESTARTS},
+        {LEFT_TO_RIGHT, VAL_MIN, LUBY_RESTARTS},
+        {DOM_SIZE_MIN,  VAL_MED, LINEAR_GEOMETRIC_RESTARTS},
+        {CHORD_COST_GUIDED, VAL_RND, LUBY_RESTARTS},            // the value selection is ignored by this brancher
+    };
+
+    /**
+     * Stop object for the workers of a portfolio. A worker stops as soon as the portfolio is over (another worker
+     * proved optimality), or when the stop object given by the user says so.
+     */
+    class PortfolioStop : public Search::Stop {
+    protected:
+        const SharedCostBound*  bound;          // the bound shared by the workers
+        Search::Stop*           userStop;       // the stop object given in the options (can be nullptr)
+    public:
+        PortfolioStop(const SharedCostBound* b, Search::Stop* s) : bound(b), userStop(s) {}
+
+        bool stop(const Search::Statistics& s, const Search::Options& o) override {
+            return bound->is_done() || (userStop != nullptr && userStop->stop(s, o));
+        }
+    };
+
+    /**
+     * The state of a worker in the portfolio
+     */
+    struct PortfolioWorker {
+        FourVoiceTexture*   model = nullptr;        // the root space of the worker, deleted once the engine is created
+        Options             options;                // the search options of the worker
+        FourVoiceTexture*   best = nullptr;         // the last (and best) solution found by the worker
+        Search::Statistics  statistics;             // the statistics of the worker's engine
+        int                 nSolutions = 0;         // the number of solutions found by the worker
+        bool                exhausted = false;      // true if the worker explored its whole search space
+    };
+
+    /**
+     * The candidate voicings of a section in the decomposed search, from the best to the worst. The candidates differ
+     * in the chords at the junctions with the neighbouring sections.
+     */
+    struct SectionPool {
+        vector<vector<int>> voicings;               // the voicings of the section [bass0, tenor0, alto0, soprano0, bass1, ...]
+        vector<vector<int>> costs;                  // the cost vector of each voicing, for the section alone
+        bool                stopped = false;        // true if the search of a candidate was stopped
+    };
+}
+
+/**
+ * @param start a point in time
+ * @return the time elapsed since then in milliseconds
+ */
+static double elapsed_ms(const std::chrono::high_resolution_clock::time_point start) {
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+    return elapsed.count();
+}
+
+/**
+ * Checks a stop object outside of a search (e.g. around the warm start)
+ * @param stop a stop object, can be nullptr
+ * @return true if the stop object stops the search
+ */
+static bool stop_fired(Search::Stop* stop) {
+    return stop != nullptr && stop->stop(Search::Statistics(), Search::Options());
+}
+
+/**
+ * Creates the cutoff object for a restart policy
+ * @param restartPolicy the restart policy (see restart_policies)
+ * @param nChords the number of chords in the piece
+ * @return a new Cutoff object. It is owned by the restart-based engine that uses it.
+ */
+static Cutoff* make_cutoff(const int restartPolicy, const int nChords) {
+    switch (restartPolicy) {
+        case LUBY_RESTARTS:
+            return Cutoff::luby(4 * nChords);
+        case GEOMETRIC_RESTARTS:
+            return Cutoff::geometric(4 * nChords, 1.5);
+        default:
+            return Cutoff::merge(
+                Cutoff::linear(2*nChords),
+                Cutoff::geometric((4*nChords)^2, 2));
+    }
+}
+
+/**
+ * Builds the solution space of a voicing of the piece
+ * @param sol a new space of the problem (e.g. a clone of a snapshot), owned by this function. It can be nullptr.
+ * @param voicing the notes of each voice for each chord [bass0, tenor0, alto0, soprano0, bass1, ...]
+ * @return the solution, or nullptr if the voicing is not a solution of the problem
+ */
+static FourVoiceTexture* voicing_to_solution(FourVoiceTexture* sol, const vector<int>& voicing) {
+    if (sol == nullptr)
+        return nullptr;
+    sol->constrain_voicing(voicing);
+    if (sol->status() == SS_FAILED) {
+        delete sol;
+        return nullptr;
+    }
+    return sol;
+}
+
+/**
+ * Builds a first solution to the Four voice texture problem with a beam search on each section (see ChainSolver). The
+ * voicings of the sections are put together and checked against the whole model, which also takes the modulations
+ * into account.
+ * @param snapshot the propagated root space of the problem
+ * @return a solution to the problem, or an empty record if the beam search did not find one
+ */
+static DiatonySolution warm_start(const DiatonySnapshot& snapshot) {
+    FourVoiceTextureParameters* params = snapshot.get_parameters();
+    vector<int> voicing(4 * params->get_totalNumberOfChords(), 0);
+    for (int s = 0; s < params->get_numberOfSections(); s++) {
+        const ChainModel model(params->get_sectionParameters(s));
+        ChainSolver solver(model);
+        if (!solver.solve(WARM_START_BEAM_WIDTH))
+            return DiatonySolution();
+        std::copy(solver.get_voicing().begin(), solver.get_voicing().end(),
+            voicing.begin() + 4 * params->get_sectionStart(s));
+    }
+    const FourVoiceTexture* sol = voicing_to_solution(snapshot.clone(), voicing);
+    if (sol == nullptr)
+        return DiatonySolution();
+    DiatonySolution record(*sol, Search::Statistics());
+    delete sol;
+    return record;
+}
 
 /**
  * Returns the best solution to the Four voice texture problem specified by the parameters. If the maximum search time
- * specified in the options is reached, the best solution found so far is returned.
+ * specified in the options is reached, the best solution found so far is returned. The search is warm started by a
+ * beam search whose solution bounds the branch and bound. It is returned without searching if the time left (given
+ * explicitly, or by a CancellableStop in the options) is under 10 ms, or if the stop object fired during the beam
+ * search.
  * @param params the parameters of the problem, containing the tonalities, chord degrees, qualities and states for each
  * chord in each progression.
- * @param opts the options for the search, containing the maximum search time, the restart strategy, etc.
+ * @param opts the options for the search, containing the maximum search time, the restart strategy, etc. Without a
+ * cutoff, the default restart strategy is used.
  * @param print whether to print the solutions found during the search
- * @return the best solution found, or nullptr if no solution was found
+ * @param timeLimit the time limit of the search in milliseconds, or a negative value if it is only known by the stop
+ * object of the options. If opts is nullptr, it replaces DEFAULT_TIME_LIMIT.
+ * @param observer called with every improving solution, including the warm start (see SolutionObserver)
+ * @return the best solution found, which is empty if no solution was found
  */
-const FourVoiceTexture* solve_diatony(FourVoiceTextureParameters* params, const Options* opts, const bool print) {
-    // create an instance of the FVT problem
-    const auto pb = new FourVoiceTexture(params);
+DiatonySolution solve_diatony(FourVoiceTextureParameters* params, const Options* opts, const bool print,
+                              const double timeLimit, const SolutionObserver& observer) {
+    const DiatonySnapshot snapshot(params);
+    return solve_diatony(snapshot, opts, print, timeLimit, observer);
+}
+
+/**
+ * Returns the best solution to the Four voice texture problem of a snapshot, like solve_diatony on its parameters. The
+ * search starts from a clone of the snapshot, so the model is neither built nor propagated at the root again. This
+ * function can be called by several threads on the same snapshot.
+ * @param snapshot the propagated root space of the problem
+ * @param opts the options for the search, containing the maximum search time, the restart strategy, etc. Without a
+ * cutoff, the default restart strategy is used.
+ * @param print whether to print the solutions found during the search
+ * @param timeLimit the time limit of the search in milliseconds, or a negative value if it is only known by the stop
+ * object of the options. If opts is nullptr, it replaces DEFAULT_TIME_LIMIT.
+ * @param observer called with every improving solution, including the warm start (see SolutionObserver)
+ * @return the best solution found, which is empty if no solution was found
+ */
+DiatonySolution solve_diatony(const DiatonySnapshot& snapshot, const Options* opts, const bool print,
+                              const double timeLimit, const SolutionObserver& observer) {
+    const auto begin = std::chrono::high_resolution_clock::now();     /// start time, for the observer
+    if (snapshot.failed()) {
+        if (print)
+            std::cout << "No solutions" << std::endl;
+        return DiatonySolution();
+    }
+    FourVoiceTextureParameters* params = snapshot.get_parameters();
+    /// the warm start does not check the stop object, so it is only checked before and after it
+    Search::Stop* userStop = opts != nullptr ? opts->stop : nullptr;
+    if (stop_fired(userStop))
+        return DiatonySolution();
+    /// warm start: the beam search finds a solution in a few milliseconds, only better solutions are searched
+    DiatonySolution best = warm_start(snapshot);
+    if (print && best.found())
+        std::cout << "Warm start:\n" << best.to_string() << std::endl;
+    if (best.found() && observer && !observer(best, elapsed_ms(begin)))
+        return best;
+    if (stop_fired(userStop))
+        return best;
+    /// the time left, if it is known: given explicitly, or by the time limit of a CancellableStop in the options
+    double budget = timeLimit;
+    const auto cancellableStop = dynamic_cast<CancellableStop*>(userStop);
+    if (budget < 0 && cancellableStop != nullptr)
+        budget = cancellableStop->remaining_time();
+    if (best.found() && budget >= 0 && budget < WARM_START_ONLY_TIME_LIMIT)
+        return best;
+
+    // start from a copy of the propagated root space
+    FourVoiceTexture* pb = snapshot.clone();
+    if (best.found())
+        pb->constrain_costs(best.get_costs());
     /// create the restart based solver with the search options
     Options options;
+    Search::Stop* defaultStop = nullptr;
     if (!opts) {
         options.threads = 1;
-        options.stop = Stop::time(60000); // stop after 120 seconds
-        options.cutoff = Cutoff::merge(
-                Cutoff::linear(2*params->get_totalNumberOfChords()),
-                Cutoff::geometric((4*params->get_totalNumberOfChords())^2, 2));
+        defaultStop = Stop::time(timeLimit >= 0 ? timeLimit : DEFAULT_TIME_LIMIT);
+        options.stop = defaultStop;
+        options.cutoff = make_cutoff(LINEAR_GEOMETRIC_RESTARTS, params->get_totalNumberOfChords());
         options.nogoods_limit = params->get_totalNumberOfChords() * 4 * 4;
     }
     else {
         options = *opts; // copy the options
+        /// the cutoff is only created here, as the engine owns it and it would leak if the search returned before
+        if (options.cutoff == nullptr)
+            options.cutoff = make_cutoff(LINEAR_GEOMETRIC_RESTARTS, params->get_totalNumberOfChords());
     }
+    /// the clone is only used by this search, so the engine takes it instead of cloning it again
+    options.clone = false;
     RBS<FourVoiceTexture, BAB> solver(pb, options);
-    delete pb;
 
     int n_sols = 0;
-    FourVoiceTexture* lastSol = nullptr;
+    bool interrupted = false;       /// whether the observer stopped the search
     const auto start = std::chrono::high_resolution_clock::now();     /// start time
     // Search for solutions
     while (FourVoiceTexture* sol_fvt = solver.next()) {
         n_sols += 1;
-        lastSol = dynamic_cast<FourVoiceTexture *>(sol_fvt->copy());
         if (print) {
             std::cout << sol_fvt->to_string() << std::endl;
             std::cout << statistics_to_string(solver.statistics()) << std::endl;
         }
+        /// only the values of the solution are kept, the space is not needed anymore
+        best = DiatonySolution(*sol_fvt, solver.statistics());
+        delete sol_fvt;
+        if (observer && !observer(best, elapsed_ms(begin))) {
+            interrupted = true;
+            break;
+        }
         //todo improve branching and search (see notes)
         //if (n_sols >= 1) break;
     }
@@ -53,9 +279,15 @@ const FourVoiceTexture* solve_diatony(FourVoiceTextureParameters* params, const
 
     if (print) {
         std::cout << "search over" << std::endl;
-        if(solver.stopped()){
+        if(interrupted){
+            std::cout << "Search stopped by the observer." << std::endl;
+        }
+        else if(solver.stopped()){
             std::cout << "Best solution not found within the time limit." << std::endl;
         }
+        else if(n_sols == 0 && best.found()){
+            std::cout << "The warm start is optimal." << std::endl;
+        }
         else if(n_sols == 0){
             std::cout << "No solutions" << std::endl;
         }
@@ -64,7 +296,434 @@ const FourVoiceTexture* solve_diatony(FourVoiceTextureParameters* params, const
         }
         std::cout << "time taken: " << duration.count() << " seconds and " << n_sols << " solutions found.\n" << std::endl;
     }
+    delete defaultStop;
+    return best;
+}
+
+/**
+ * Returns the best solution to the Four voice texture problem specified by the parameters, using a portfolio of
+ * restart-based branch and bound engines running in parallel. Each worker uses a different branching, random seed and
+ * restart policy. The workers share the best cost vector found so far, and they all stop as soon as one of them proves
+ * optimality. If the stop object of the options stops the search, the best solution found so far is returned.
+ * @param params the parameters of the problem, containing the tonalities, chord degrees, qualities and states for each
+ * chord in each progression.
+ * @param opts the options for the search. Only the stop object and the no-goods limit are used, as each worker has its
+ * own cutoff and runs on a single thread.
+ * @param print whether to print the solutions found during the search
+ * @param nWorkers the number of workers. If it is 0, one worker per hardware thread is used.
+ * @param observer called with every solution that improves on the best one of the portfolio (see SolutionObserver).
+ * The calls are serialized, but they are made from the threads of the workers.
+ * @return the best solution found, or nullptr if no solution was found
+ */
+const FourVoiceTexture* solve_diatony_portfolio(FourVoiceTextureParameters* params, const Options* opts,
+                                                const bool print, unsigned int nWorkers,
+                                                const SolutionObserver& observer) {
+    check_parameters(params);
+    if (nWorkers == 0)
+        nWorkers = std::max(1U, std::thread::hardware_concurrency());
+    const int nChords = params->get_totalNumberOfChords();
+
+    Search::Stop* userStop = opts != nullptr ? opts->stop : Stop::time(DEFAULT_TIME_LIMIT);
+    const unsigned int nogoodsLimit = opts != nullptr ? opts->nogoods_limit : nChords * 4 * 4;
+
+    SharedCostBound bound;
+    vector<PortfolioWorker> workers(nWorkers);
+    /// the models are created sequentially, only the search is done in parallel
+    for (unsigned int w = 0; w < nWorkers; w++) {
+        const PortfolioAsset& asset = portfolioAssets[w % portfolioAssets.size()];
+        workers[w].model = new FourVoiceTexture(params, asset.variableSelection, asset.valueSelection, w + 1);
+        workers[w].model->set_shared_bound(&bound);
+        workers[w].options.threads = 1;
+        workers[w].options.stop = new PortfolioStop(&bound, userStop);
+        workers[w].options.cutoff = make_cutoff(asset.restartPolicy, nChords);
+        workers[w].options.nogoods_limit = nogoodsLimit;
+    }
+
+    /// serializes the solutions of the workers, so that the observer sees strictly improving solutions
+    std::mutex solutionLock;
+    bool interrupted = false;       /// whether the observer stopped the search (protected by solutionLock)
+    const auto start = std::chrono::high_resolution_clock::now();     /// start time
+    vector<std::thread> threads;
+    threads.reserve(nWorkers);
+    for (unsigned int w = 0; w < nWorkers; w++) {
+        threads.emplace_back([&workers, &bound, &solutionLock, &interrupted, &start, &observer, print, w]() {
+            PortfolioWorker& worker = workers[w];
+            RBS<FourVoiceTexture, BAB> solver(worker.model, worker.options);
+            delete worker.model;
+            worker.model = nullptr;
+
+            bool dropped = false;   /// whether a solution was dropped after the observer stopped the search
+            while (FourVoiceTexture* sol = solver.next()) {
+                const vector<int> costs = sol->get_cost_values();
+                std::lock_guard<std::mutex> guard(solutionLock);
+                /// the solutions found by the other workers after the observer stopped the search are dropped, so that
+                /// the solution returned is the last one the observer was given
+                if (interrupted) {
+                    delete sol;
+                    dropped = true;
+                    break;
+                }
+                worker.nSolutions += 1;
+                delete worker.best;
+                worker.best = sol;
+                if (!bound.update(costs))
+                    continue;
+                const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+                if (print)
+                    std::cout << "worker " << w << " found cost {" << int_vector_to_string(costs) << "} after "
+                              << elapsed.count() << " seconds" << std::endl;
+                if (observer && !observer(DiatonySolution(*sol, solver.statistics()), 1000 * elapsed.count())) {
+                    interrupted = true;
+                    bound.finish();
+                }
+            }
+            worker.statistics = solver.statistics();
+            /// the search space of a worker is always bounded by the best shared cost, so exhausting it proves that
+            /// the best solution found by the portfolio is optimal
+            if (!solver.stopped() && !dropped) {
+                worker.exhausted = true;
+                bound.finish();
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+    const std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+
+    /// keep the best solution over all workers
+    FourVoiceTexture* bestSol = nullptr;
+    vector<int> bestCosts;
+    bool optimal = false;
+    int n_sols = 0;
+    Search::Statistics statistics;
+    for (auto& worker : workers) {
+        n_sols += worker.nSolutions;
+        statistics += worker.statistics;
+        optimal = optimal || worker.exhausted;
+        delete worker.options.stop;
+        if (worker.best == nullptr)
+            continue;
+        const vector<int> costs = worker.best->get_cost_values();
+        if (bestSol == nullptr || std::lexicographical_compare(costs.begin(), costs.end(), bestCosts.begin(), bestCosts.end())) {
+            delete bestSol;
+            bestSol = worker.best;
+            bestCosts = costs;
+        }
+        else {
+            delete worker.best;
+        }
+    }
+    if (opts == nullptr)
+        delete userStop;
+
+    if (print) {
+        std::cout << "search over" << std::endl;
+        if (interrupted)
+            std::cout << "Search stopped by the observer." << std::endl;
+        else if (!optimal)
+            std::cout << "Best solution not found within the time limit." << std::endl;
+        else if (bestSol == nullptr)
+            std::cout << "No solutions" << std::endl;
+        else
+            std::cout << "Best solution found." << std::endl;
+        std::cout << statistics_to_string(statistics) << std::endl;
+        std::cout << "time taken: " << duration.count() << " seconds with " << nWorkers << " workers and " << n_sols
+                  << " solutions found.\n" << std::endl;
+    }
+    return bestSol;
+}
+
+/**
+ * Returns a good solution to the Four voice texture problem specified by the parameters using Large Neighbourhood
+ * Search. After a first solution is found, each restart keeps the best voicing found so far and relaxes either a window
+ * of chords, a single voice or the boundary between two sections. LNS never proves optimality, so the search runs until
+ * the stop object of the options stops it, and the best solution found is returned.
+ * @param params the parameters of the problem, containing the tonalities, chord degrees, qualities and states for each
+ * chord in each progression.
+ * @param opts the options for the search. If no cutoff is given, a Luby cutoff scaled on the window size is used. No-goods
+ * are disabled since they are not valid outside of the neighbourhood they were learnt in.
+ * @param print whether to print the improvements of the cost vector over time
+ * @param windowSize the maximum number of consecutive chords relaxed at each restart
+ * @param seed the seed used to pick the neighbourhoods and for the value selection
+ * @return the best solution found, or nullptr if no solution was found
+ */
+const FourVoiceTexture* solve_diatony_lns(FourVoiceTextureParameters* params, const Options* opts, const bool print,
+                                          const int windowSize, const unsigned int seed) {
+    check_parameters(params);
+    const auto pb = new FourVoiceTexture(params, RIGHT_TO_LEFT, VAL_RND, seed);
+    pb->set_lns(windowSize, seed);
+
+    Options options;
+    if (!opts) {
+        options.threads = 1;
+        options.stop = Stop::time(DEFAULT_TIME_LIMIT);
+    }
+    else {
+        options = *opts;
+    }
+    if (options.cutoff == nullptr)
+        options.cutoff = make_cutoff(LUBY_RESTARTS, 4 * windowSize);
+    options.nogoods_limit = 0;
+
+    RBS<FourVoiceTexture, BAB> solver(pb, options);
+    delete pb;
+
+    int n_sols = 0;
+    FourVoiceTexture* lastSol = nullptr;
+    const auto start = std::chrono::high_resolution_clock::now();     /// start time
+    while (FourVoiceTexture* sol = solver.next()) {
+        n_sols += 1;
+        delete lastSol;
+        lastSol = sol;
+        if (print) {
+            const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+            std::cout << elapsed.count() << " s, restart " << solver.statistics().restart << ": cost {"
+                      << int_vector_to_string(sol->get_cost_values()) << "}" << std::endl;
+        }
+    }
+    const std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+
+    if (print) {
+        std::cout << "search over" << std::endl;
+        if (n_sols == 0)
+            std::cout << "No solutions" << std::endl;
+        std::cout << statistics_to_string(solver.statistics()) << std::endl;
+        std::cout << "time taken: " << duration.count() << " seconds and " << n_sols << " improving solutions found.\n"
+                  << std::endl;
+    }
+    if (!opts)
+        delete options.stop;
+    return lastSol;
+}
+
+/**
+ * Fills the pool of candidate voicings of a section by solving the section alone. Each candidate is the best voicing
+ * of the section whose chords at the junctions with the neighbouring sections differ from those of all the previous
+ * candidates.
+ * @param params the parameters of the whole piece
+ * @param section the index of the section
+ * @param poolSize the maximum number of candidates
+ * @param stop the stop object of the search (not owned)
+ * @param nogoodsLimit the no-goods limit of the restart-based search
+ * @param pool the pool to fill
+ */
+static void fill_section_pool(const FourVoiceTextureParameters* params, const int section, const int poolSize,
+                              Search::Stop* stop, const unsigned int nogoodsLimit, SectionPool& pool) {
+    const TonalProgressionParameters* sectionParams = params->get_sectionParameters(section);
+    const int size = sectionParams->get_size();
+    /// the section alone, as a piece starting at position 0
+    TonalProgressionParameters localSection(0, size, 0, size - 1, sectionParams->get_tonality(),
+        sectionParams->get_chordDegrees(), sectionParams->get_chordQualities(), sectionParams->get_chordStates());
+    FourVoiceTextureParameters localParams(size, 1, {&localSection}, {});
+
+    /// the chords of the section that are at a junction with another section
+    vector<int> junctions;
+    if (section > 0)
+        junctions.push_back(0);
+    if (section < params->get_numberOfSections() - 1 && size - 1 != 0)
+        junctions.push_back(size - 1);
+
+    for (int k = 0; k < poolSize; k++) {
+        const auto pb = new FourVoiceTexture(&localParams, RIGHT_TO_LEFT, VAL_RND, k + 1);
+        for (const auto& voicing : pool.voicings) {
+            vector<int> junctionVoicing;
+            for (const int chord : junctions)
+                junctionVoicing.insert(junctionVoicing.end(), voicing.begin() + chord * 4, voicing.begin() + (chord + 1) * 4);
+            pb->forbid_chords_voicing(junctions, junctionVoicing);
+        }
+        Options options;
+        options.threads = 1;
+        options.stop = stop;
+        options.cutoff = make_cutoff(LINEAR_GEOMETRIC_RESTARTS, size);
+        options.nogoods_limit = nogoodsLimit;
+        RBS<FourVoiceTexture, BAB> solver(pb, options);
+        delete pb;
+
+        FourVoiceTexture* best = nullptr;
+        while (FourVoiceTexture* sol = solver.next()) {
+            delete best;
+            best = sol;
+        }
+        pool.stopped = pool.stopped || solver.stopped();
+        if (best == nullptr)
+            break;
+        pool.voicings.push_back(best->get_voicing_values());
+        pool.costs.push_back(best->get_cost_values());
+        delete best;
+        /// a single section has no junctions, and no more candidates are searched once the time is up
+        if (junctions.empty() || pool.stopped)
+            break;
+    }
+}
+
+/**
+ * Returns a good solution to the Four voice texture problem specified by the parameters by decomposing the piece into
+ * its sections. Sections only interact at the modulations, so each section is first solved alone on its own thread,
+ * keeping a small pool of good voicings that differ in the chords at the junctions. A final stitching search then
+ * solves the whole piece, where each section can only take one of its candidate voicings, so that the constraints and
+ * costs at the modulations are taken into account. The solution is not guaranteed to be optimal. If the candidates
+ * cannot be stitched together (e.g. the pivot chords of two sections never match), the whole piece is solved with
+ * solve_diatony. If the stitching search is stopped before its first solution, the best candidates of the sections are
+ * put together as they are, if they form a solution.
+ * @param params the parameters of the problem, containing the tonalities, chord degrees, qualities and states for each
+ * chord in each progression.
+ * @param opts the options for the search. Only the stop object and the no-goods limit are used by the sub-problems, the
+ * fallback search uses all of them.
+ * @param print whether to print the pools and the stitched solution
+ * @param poolSize the maximum number of candidate voicings kept for each section
+ * @return the best solution found, or nullptr if no solution was found
+ */
+const FourVoiceTexture* solve_diatony_decomposed(FourVoiceTextureParameters* params, const Options* opts,
+                                                 const bool print, const int poolSize) {
+    if (poolSize < 1)
+        throw std::invalid_argument("The pool size must be at least 1, got " + std::to_string(poolSize));
+    check_parameters(params);
+    const int nSections = params->get_numberOfSections();
+
+    Search::Stop* userStop = opts != nullptr ? opts->stop : Stop::time(DEFAULT_TIME_LIMIT);
+    const unsigned int nogoodsLimit = opts != nullptr ? opts->nogoods_limit : params->get_totalNumberOfChords() * 4 * 4;
+
+    /// solve each section alone, in parallel
+    const auto start = std::chrono::high_resolution_clock::now();     /// start time
+    vector<SectionPool> pools(nSections);
+    vector<std::thread> threads;
+    threads.reserve(nSections);
+    for (int s = 0; s < nSections; s++)
+        threads.emplace_back(fill_section_pool, params, s, poolSize, userStop, nogoodsLimit, std::ref(pools[s]));
+    for (auto& t : threads)
+        t.join();
+    const std::chrono::duration<double> poolDuration = std::chrono::high_resolution_clock::now() - start;
+
+    if (print) {
+        for (int s = 0; s < nSections; s++) {
+            std::cout << "section " << s << ": " << pools[s].voicings.size() << " candidates" << (pools[s].stopped ?
+                " (search stopped)" : "") << std::endl;
+            for (const auto& costs : pools[s].costs)
+                std::cout << "\tcost {" << int_vector_to_string(costs) << "}" << std::endl;
+        }
+        std::cout << "sections solved in " << poolDuration.count() << " seconds" << std::endl;
+    }
+
+    /// stitch the candidates together
+    const FourVoiceTexture* bestSol = nullptr;
+    bool emptyPool = false;
+    for (const auto& pool : pools)
+        emptyPool = emptyPool || pool.voicings.empty();
+    if (!emptyPool) {
+        const auto pb = new FourVoiceTexture(params, RIGHT_TO_LEFT, VAL_MIN);
+        for (int s = 0; s < nSections; s++)
+            pb->restrict_section_voicing(s, pools[s].voicings);
+        Options options;
+        options.threads = 1;
+        options.stop = userStop;
+        BAB<FourVoiceTexture> stitcher(pb, options);
+        delete pb;
+        while (FourVoiceTexture* sol = stitcher.next()) {
+            delete bestSol;
+            bestSol = sol;
+        }
+        /// the stitching search is stopped before its first solution if the sections used up the budget, the best
+        /// candidates of the sections are then put together as they are
+        if (bestSol == nullptr && stitcher.stopped()) {
+            vector<int> voicing(4 * params->get_totalNumberOfChords(), 0);
+            for (int s = 0; s < nSections; s++)
+                std::copy(pools[s].voicings[0].begin(), pools[s].voicings[0].end(),
+                    voicing.begin() + 4 * params->get_sectionStart(s));
+            bestSol = voicing_to_solution(new FourVoiceTexture(params, RIGHT_TO_LEFT, VAL_MIN), voicing);
+        }
+    }
+    const std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+
+    /// a section without candidates has no solution on its own, unless its search was stopped
+    bool infeasible = false;
+    for (const auto& pool : pools)
+        infeasible = infeasible || (pool.voicings.empty() && !pool.stopped);
+
+    if (print) {
+        if (bestSol != nullptr)
+            std::cout << bestSol->to_string() << std::endl;
+        else if (infeasible)
+            std::cout << "No solutions" << std::endl;
+        else
+            std::cout << "The candidates could not be stitched together, solving the whole piece." << std::endl;
+        std::cout << "time taken: " << duration.count() << " seconds.\n" << std::endl;
+    }
+    if (bestSol == nullptr && !infeasible) {
+        /// the fallback search is stopped by the same stop object, so that it does not outlive a cancelled search
+        Options fallback;
+        if (opts != nullptr)
+            fallback = *opts;
+        else {
+            fallback.threads = 1;
+            fallback.stop = userStop;
+            fallback.nogoods_limit = nogoodsLimit;
+        }
+        const DiatonySnapshot snapshot(params);
+        const DiatonySolution sol = solve_diatony(snapshot, &fallback, print);
+        if (sol.found())
+            bestSol = voicing_to_solution(snapshot.clone(), sol.get_voicing());
+    }
+    if (opts == nullptr)
+        delete userStop;
+    return bestSol;
+}
+
+/**
+ * Returns the best solution to the Four voice texture problem specified by the parameters, using the voicing index
+ * formulation (see VoicingIndexModel) with the same search as solve_diatony. The piece must contain a single section.
+ * @param params the parameters of the problem, containing the tonalities, chord degrees, qualities and states for each
+ * chord in each progression.
+ * @param opts the options for the search, containing the maximum search time, the restart strategy, etc.
+ * @param print whether to print the solutions found during the search
+ * @return the best solution found, or nullptr if no solution was found
+ */
+const VoicingIndexModel* solve_diatony_voicing_index(FourVoiceTextureParameters* params, const Options* opts,
+                                                     const bool print) {
+    check_parameters(params);
+    const auto pb = new VoicingIndexModel(params);
+    Options options;
+    if (!opts) {
+        options.threads = 1;
+        options.stop = Stop::time(DEFAULT_TIME_LIMIT);
+        options.cutoff = make_cutoff(LINEAR_GEOMETRIC_RESTARTS, params->get_totalNumberOfChords());
+        options.nogoods_limit = params->get_totalNumberOfChords() * 4 * 4;
+    }
+    else {
+        options = *opts;
+        /// the restart engine throws without a cutoff, so the default schedule is used as in solve_diatony
+        if (options.cutoff == nullptr)
+            options.cutoff = make_cutoff(LINEAR_GEOMETRIC_RESTARTS, params->get_totalNumberOfChords());
+    }
+    RBS<VoicingIndexModel, BAB> solver(pb, options);
+    delete pb;
+
+    int n_sols = 0;
+    VoicingIndexModel* lastSol = nullptr;
+    const auto start = std::chrono::high_resolution_clock::now();     /// start time
+    while (VoicingIndexModel* sol = solver.next()) {
+        n_sols += 1;
+        delete lastSol;
+        lastSol = sol;
+        if (print) {
+            std::cout << sol->to_string() << std::endl;
+            std::cout << statistics_to_string(solver.statistics()) << std::endl;
+        }
+    }
+    const std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+
+    if (print) {
+        std::cout << "search over" << std::endl;
+        if (solver.stopped())
+            std::cout << "Best solution not found within the time limit." << std::endl;
+        else if (n_sols == 0)
+            std::cout << "No solutions" << std::endl;
+        else
+            std::cout << "Best solution found." << std::endl;
+        std::cout << "time taken: " << duration.count() << " seconds and " << n_sols << " solutions found.\n" << std::endl;
+    }
+    if (!opts)
+        delete options.stop;
     return lastSol;
 }
 
-//todo other functions (returning all sols, finding approximately optimal solutions, etc.)
\ No newline at end of file
+//todo other functions (returning all sols, finding approximately optimal solutions, etc.)
@@ -0,0 +1,203 @@
+#include "../../headers/diatony/VoicingIndexModel.hpp"
+
+/**
+ * Constructor. Enumerates the legal voicings of each chord and the legal transitions between them.
+ * @param params An object containing the parameters for the whole piece. It must contain exactly one section.
+ * @param seed the seed used by the value selection
+ */
+VoicingIndexModel::VoicingIndexModel(FourVoiceTextureParameters* params, const unsigned int seed) : params(params) {
+    if (params->get_numberOfSections() != 1)
+        throw std::invalid_argument("The voicing index model only handles pieces with a single section, got " +
+            std::to_string(params->get_numberOfSections()) + " sections.");
+    const ChainModel model(params->get_sectionParameters(0));
+    const int size = model.get_size();
+
+    /// a chord without any legal voicing makes the problem infeasible
+    for (int i = 0; i < size; i++) {
+        if (model.get_voicings(i).empty()) {
+            fail();
+            return;
+        }
+    }
+
+    /// Variables initialization
+    voicingStates                           = IntVarArray(*this, size);
+    fullVoicing                             = IntVarArray(*this, nVoices * size, BASS_MIN, SOPRANO_MAX);
+
+    incompleteChords                        = IntVarArray(*this, size, 0, 1);
+    diminishedChordsWith4Notes              = IntVarArray(*this, size, 0, 1);
+    chordsWithLessThan4Values               = IntVarArray(*this, size, 0, 1);
+    transitionMelodicCosts                  = IntVarArray(*this, std::max(0, size - 1), 0, nVoices * MAX_MELODIC_COST);
+    transitionCommonNotes                   = IntVarArray(*this, std::max(0, size - 1), 0, nVoices);
+
+    costOfMelodicIntervals                  = IntVar(*this, 0, nVoices * std::max(0, size - 1) * MAX_MELODIC_COST);
+    nOfFundStateDiminishedChordsWith4notes  = IntVar(*this, 0, size);
+    nOfChordsWithLessThan4Values            = IntVar(*this, 0, size);
+    nOfIncompleteChords                     = IntVar(*this, 0, size);
+    nOfCommonNotesInSameVoice               = IntVar(*this, - nVoices * std::max(0, size - 1), 0);
+
+    /**------------------------------------------------ chords -------------------------------------------------**/
+    for (int i = 0; i < size; i++) {
+        const auto& voicings = model.get_voicings(i);
+        const int nStates = 2 * static_cast<int>(voicings.size());
+
+        /// only motion dependent chords use the odd states
+        vector<int> validStates;
+        for (int state = 0; state < nStates; state++)
+            if (state % 2 == 0 || model.is_motion_dependent(i))
+                validStates.push_back(state);
+        voicingStates[i] = IntVar(*this, IntSet(validStates.data(), static_cast<int>(validStates.size())));
+
+        /// channel the notes of each voice and the costs of the chord from its state
+        for (int v = BASS; v <= SOPRANO; v++) {
+            IntArgs notes(nStates);
+            for (int state = 0; state < nStates; state++)
+                notes[state] = voicings[state / 2][v];
+            element(*this, notes, voicingStates[i], fullVoicing[i * nVoices + v]);
+        }
+        IntArgs incomplete(nStates), diminished(nStates), lessThan4Values(nStates);
+        for (int state = 0; state < nStates; state++) {
+            const CostVector& costs = model.get_chord_cost(i, state / 2);
+            incomplete[state] = costs[0];
+            diminished[state] = costs[1];
+            lessThan4Values[state] = costs[2];
+        }
+        element(*this, incomplete, voicingStates[i], incompleteChords[i]);
+        element(*this, diminished, voicingStates[i], diminishedChordsWith4Notes[i]);
+        element(*this, lessThan4Values, voicingStates[i], chordsWithLessThan4Values[i]);
+    }
+
+    /**---------------------------------------------- transitions ----------------------------------------------**/
+    /// same transitions as the ones explored by ChainSolver: [state i, state i+1, melodic cost, common notes]
+    for (int i = 0; i < size - 1; i++) {
+        const auto& currentVoicings = model.get_voicings(i);
+        const auto& nextVoicings = model.get_voicings(i + 1);
+        TupleSet transitions(4);
+        for (int state = 0; state < 2 * static_cast<int>(currentVoicings.size()); state++) {
+            if (state % 2 == 1 && !model.is_motion_dependent(i))
+                continue;
+            const ChordVoicing& current = currentVoicings[state / 2];
+            const bool approachedByContraryMotion = state % 2 == 1;
+            for (int k = 0; k < static_cast<int>(nextVoicings.size()); k++) {
+                const ChordVoicing& next = nextVoicings[k];
+                if (!model.is_legal_transition(i, current, next))
+                    continue;
+                const bool contraryMotion = ChainModel::stepwise_contrary_motion(current, next);
+                /// the third of a motion dependent chord is doubled iff it is surrounded by stepwise contrary motion
+                if (model.is_motion_dependent(i) &&
+                    model.count_thirds(i, current) != (approachedByContraryMotion && contraryMotion ? 2 : 1))
+                    continue;
+                const int nextState = 2 * k + (model.is_motion_dependent(i + 1) && contraryMotion ? 1 : 0);
+                const CostVector cost = ChainModel::transition_cost(current, next);
+                transitions.add(IntArgs({state, nextState, cost[3], -cost[4]}));
+            }
+        }
+        transitions.finalize();
+        extensional(*this, IntVarArgs({voicingStates[i], voicingStates[i + 1], transitionMelodicCosts[i],
+            transitionCommonNotes[i]}), transitions);
+    }
+
+    /**------------------------------------------------- costs -------------------------------------------------**/
+    linear(*this, incompleteChords, IRT_EQ, nOfIncompleteChords);
+    linear(*this, diminishedChordsWith4Notes, IRT_EQ, nOfFundStateDiminishedChordsWith4notes);
+    linear(*this, chordsWithLessThan4Values, IRT_EQ, nOfChordsWithLessThan4Values);
+    linear(*this, transitionMelodicCosts, IRT_EQ, costOfMelodicIntervals);
+    linear(*this, transitionCommonNotes, IRT_EQ, expr(*this, -nOfCommonNotesInSameVoice));
+
+    costVector = {nOfIncompleteChords, nOfFundStateDiminishedChordsWith4notes, nOfChordsWithLessThan4Values,
+        costOfMelodicIntervals, nOfCommonNotesInSameVoice};
+
+    /// same variable order as the default branching of FourVoiceTexture: from the last chord to the first
+    auto r_to_l = [](const Space&, const IntVar&, int i) {
+        return i;
+    };
+    branch(*this, voicingStates, INT_VAR_MERIT_MAX(r_to_l), INT_VAL_RND(Rnd(seed)));
+}
+
+/**
+ * Copy constructor
+ * @param s A VoicingIndexModel object to copy.
+ */
+VoicingIndexModel::VoicingIndexModel(VoicingIndexModel& s) : IntLexMinimizeSpace(s) {
+    nVoices = s.nVoices;
+    params = s.params;
+
+    voicingStates.update(*this, s.voicingStates);
+    fullVoicing.update(*this, s.fullVoicing);
+
+    incompleteChords.update(*this, s.incompleteChords);
+    diminishedChordsWith4Notes.update(*this, s.diminishedChordsWith4Notes);
+    chordsWithLessThan4Values.update(*this, s.chordsWithLessThan4Values);
+    transitionMelodicCosts.update(*this, s.transitionMelodicCosts);
+    transitionCommonNotes.update(*this, s.transitionCommonNotes);
+
+    costOfMelodicIntervals.update(*this, s.costOfMelodicIntervals);
+    nOfFundStateDiminishedChordsWith4notes.update(*this, s.nOfFundStateDiminishedChordsWith4notes);
+    nOfChordsWithLessThan4Values.update(*this, s.nOfChordsWithLessThan4Values);
+    nOfIncompleteChords.update(*this, s.nOfIncompleteChords);
+    nOfCommonNotesInSameVoice.update(*this, s.nOfCommonNotesInSameVoice);
+
+    costVector = {nOfIncompleteChords, nOfFundStateDiminishedChordsWith4notes, nOfChordsWithLessThan4Values,
+        costOfMelodicIntervals, nOfCommonNotesInSameVoice};
+}
+
+/**
+ * Returns the values of the cost variables in a solution
+ * @return a vector containing the value of each cost in lexicographical order, in the same order as FourVoiceTexture
+ */
+vector<int> VoicingIndexModel::get_cost_values() const {
+    vector<int> costs;
+    costs.reserve(costVector.size());
+    for (int i = 0; i < costVector.size(); i++)
+        costs.push_back(costVector[i].val());
+    return costs;
+}
+
+/**
+ * Returns the values of the voicing variables in a solution
+ * @return a vector containing the notes of each voice for each chord [bass0, tenor0, alto0, soprano0, bass1, ...]
+ */
+vector<int> VoicingIndexModel::get_voicing_values() const {
+    vector<int> voicing;
+    voicing.reserve(fullVoicing.size());
+    for (int i = 0; i < fullVoicing.size(); i++)
+        voicing.push_back(fullVoicing[i].val());
+    return voicing;
+}
+
+/**
+ * General space copy method
+ * @return a new VoicingIndexModel object that is a copy of this one, as a Space pointer
+ */
+Space* VoicingIndexModel::copy() {
+    return new VoicingIndexModel(*this);
+}
+
+/**
+ * Cost function
+ * @return the cost vector containing the cost variables in lexicographical order
+ */
+IntVarArgs VoicingIndexModel::cost() const {
+    return costVector;
+}
+
+/**
+ * to_string method for the VoicingIndexModel object.
+ * @return a string representation of the VoicingIndexModel object
+ */
+string VoicingIndexModel::to_string() const {
+    string message;
+    message += "Voicing index model object:\n";
+    message += "Parameters: " + params->toString() + "\n";
+    message += "Voicing states:" + intVarArray_to_string(voicingStates) + "\n";
+    message += "Full voicing array:" + intVarArray_to_string(fullVoicing) + "\n\n";
+
+    message += "Cost variables:\n";
+    message += "Number of incomplete chords: " + intVar_to_string(nOfIncompleteChords) + "\n";
+    message += "Number of fundamental state diminished chords with 4 notes: " +
+        intVar_to_string(nOfFundStateDiminishedChordsWith4notes) + "\n";
+    message += "Number of chords with less than 4 values: " + intVar_to_string(nOfChordsWithLessThan4Values) + "\n";
+    message += "Cost of melodic intervals: " + intVar_to_string(costOfMelodicIntervals) + "\n";
+    message += "Number of common notes in the same voice: " + intVar_to_string(nOfCommonNotesInSameVoice) + "\n";
+    return message;
+}
@@ -26,19 +26,19 @@ int main(int argc, char* argv[]) {
         return 1;
 
     /// Data for the problem
-    Tonality* CMajor = new MajorTonality(C);
-    Tonality* GMajor = new MajorTonality(G);
+    const Tonality* CMajor = Tonality::get_tonality(C, MAJOR_MODE);
+    const Tonality* GMajor = Tonality::get_tonality(G, MAJOR_MODE);
 
-    Tonality* CMinor = new MinorTonality(C);
-    Tonality* EbMajor = new MajorTonality(E_FLAT);
+    const Tonality* CMinor = Tonality::get_tonality(C, MINOR_MODE);
+    const Tonality* EbMajor = Tonality::get_tonality(E_FLAT, MAJOR_MODE);
 
-    vector<Tonality*> tonalities = {CMajor};
+    vector<const Tonality*> tonalities = {CMajor};
 
 
     std::string search_type = argv[1];
     std::string build_midi = argv[2];
 
-    Tonality* t1 = CMinor;
+    const Tonality* t1 = CMinor;
     /// vectors representing the chords and the states
     vector<int> chords = {FIRST_DEGREE, SIXTH_DEGREE, SECOND_DEGREE, FIFTH_DEGREE_APPOGIATURA, FIFTH_DEGREE, FIRST_DEGREE
     };
@@ -54,7 +54,7 @@ int main(int argc, char* argv[]) {
         chords_qualities1, states1);
 
 
-    Tonality* t2 = EbMajor;
+    const Tonality* t2 = EbMajor;
     vector<int> chords2 = {FIRST_DEGREE, SIXTH_DEGREE, FIVE_OF_FIVE, FIFTH_DEGREE, FIRST_DEGREE
     };
     vector<int> chords_qualities2;
@@ -73,21 +73,19 @@ int main(int argc, char* argv[]) {
 
     auto pieceParams = new FourVoiceTextureParameters(11, 2, sectionParams, modulationParams);
 
+    CancellableStop stop(DEFAULT_TIME_LIMIT);
     Options opts;
     opts.threads = 1;
-    opts.stop = Stop::time(60000); // stop after 120 seconds
-    opts.cutoff = Cutoff::merge(
-            Cutoff::linear(2*pieceParams->get_totalNumberOfChords()),
-            Cutoff::geometric((4*pieceParams->get_totalNumberOfChords())^2, 2));
+    opts.stop = &stop;
     opts.nogoods_limit = pieceParams->get_totalNumberOfChords() * 4 * 4;
 
-    auto sol = solve_diatony(pieceParams, &opts, true);
-    if (sol != nullptr)
-        std::cout << "Solution: " << sol->to_string() << std::endl;
+    const DiatonySolution sol = solve_diatony(pieceParams, &opts, true);
+    if (sol.found())
+        std::cout << "Solution: " << sol.to_string() << std::endl;
     else
         std::cout << "No solution found." << std::endl;
-    if(build_midi == "true" && sol != nullptr){
-            writeSolToMIDIFile(sol->getParameters()->get_totalNumberOfChords(), "../out/MidiFiles/sol", sol);
+    if(build_midi == "true" && sol.found()){
+            writeSolToMIDIFile(sol.get_number_of_chords(), "../out/MidiFiles/sol", sol.get_voicing());
         cout << "MIDI file(s) created" << endl;
     }
 
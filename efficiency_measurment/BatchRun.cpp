@@ -0,0 +1,94 @@
+#include <fstream>
+#include <sstream>
+
+#include "../c++/headers/diatony/BatchSolver.hpp"
+#include "../c++/headers/aux/Utilities.hpp"
+#include "../c++/headers/aux/Tonality.hpp"
+
+#include "TestCases.hpp"
+
+using namespace Gecode;
+using namespace std;
+
+/**
+ * Solves a batch of test cases inside a single process (see BatchSolver), instead of starting one parallelRun process
+ * per test case as launch_tests.sh does. Each line of the input has the same format as the arguments of parallelRun:
+ *    - The number of the test case
+ *    - The tonic of the tonality
+ *    - The mode of the tonality
+ *    - The number of the variable branching strategy
+ *    - The number of the value branching strategy
+ * It takes as optional arguments:
+ *    - The input file (TestCases.txt by default, - for the standard input)
+ *    - The time budget of each job in milliseconds (60 seconds by default)
+ *    - The deadline of the whole batch in milliseconds (none by default)
+ *    - The number of worker threads (one per hardware thread by default)
+ * It prints a CSV line per job as soon as it finishes, then the total time of the batch.
+ */
+int main(int argc, char* argv[]) {
+    const string inputFile = argc > 1 ? argv[1] : "TestCases.txt";
+    const double jobTimeLimit = argc > 2 ? stod(argv[2]) : 60000;
+    const double deadline = argc > 3 ? stod(argv[3]) : -1;
+    const unsigned int nWorkers = argc > 4 ? stoul(argv[4]) : 0;
+
+    ifstream file;
+    if (inputFile != "-") {
+        file.open(inputFile);
+        if (!file) {
+            cerr << "Could not open " << inputFile << endl;
+            return 1;
+        }
+    }
+    istream& input = inputFile != "-" ? file : cin;
+
+    /// the parameters of each job, and the name of its test case and tonality for the output
+    vector<TonalProgressionParameters*> sectionParams;
+    vector<FourVoiceTextureParameters*> params;
+    vector<string> names;
+    vector<BatchJob> jobs;
+    string line;
+    while (getline(input, line)) {
+        istringstream fields(line);
+        int testCase, tonic, mode, variableSelection, valueSelection;
+        if (!(fields >> testCase >> tonic >> mode >> variableSelection >> valueSelection))
+            continue;
+        if (testCase < 0 || testCase >= static_cast<int>(testCases.size())) {
+            cerr << "Unknown test case " << testCase << ", line ignored: " << line << endl;
+            continue;
+        }
+        const Tonality* tonality;
+        try {
+            tonality = Tonality::get_tonality(tonic, mode);
+        }
+        catch (const invalid_argument& e) {
+            cerr << e.what() << ", line ignored: " << line << endl;
+            continue;
+        }
+        const int size = static_cast<int>(testCases[testCase][0].size());
+        sectionParams.push_back(new TonalProgressionParameters(0, size, 0, size - 1, tonality, testCases[testCase][0],
+            mode == MAJOR_MODE ? testCases[testCase][1] : testCases[testCase][2], testCases[testCase][3]));
+        params.push_back(new FourVoiceTextureParameters(size, 1, {sectionParams.back()}, {}));
+        names.push_back(testCasesNames[testCase] + " , " + tonality->get_name());
+        jobs.emplace_back(static_cast<int>(jobs.size()), params.back(), jobTimeLimit, variableSelection,
+            valueSelection);
+    }
+
+    const BatchSolver solver(nWorkers, jobTimeLimit, deadline);
+    cout << "Chord progression , Tonality , status , time (ms) , costs" << endl;
+    const auto start = std::chrono::high_resolution_clock::now();
+    solver.solve(jobs, [&names](const BatchResult& result) {
+        cout << names[result.id] << " , " << batch_job_status_names[result.status] << " , " << result.time << " , "
+             << (result.status == JOB_INVALID || result.status == JOB_ERROR ? result.error :
+                 int_vector_to_string(result.solution.get_costs()))
+             << endl;
+    });
+    const std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+    cout << jobs.size() << " jobs solved by " << solver.get_number_of_workers() << " workers in " << duration.count()
+         << " ms" << endl;
+
+    for (int i = 0; i < static_cast<int>(params.size()); i++) {
+        delete params[i];
+        delete sectionParams[i];
+    }
+    return 0;
+}
@@ -76,7 +76,7 @@ int main(int argc, char* argv[]) {
  *                                                                                                                     *
  ***********************************************************************************************************************/
 
-    vector<int> var_sel = {DEGREE_MAX, DOM_SIZE_MIN, LEFT_TO_RIGHT, RIGHT_TO_LEFT}; //@todo add left to right but soprano to bass and not bass to soprano
+    vector<int> var_sel = {DEGREE_MAX, DOM_SIZE_MIN, LEFT_TO_RIGHT, RIGHT_TO_LEFT, CHORD_COST_GUIDED}; //@todo add left to right but soprano to bass and not bass to soprano
     vector<int> val_sel = {VAL_MIN, VAL_MAX}; // @todo add custom ones
 
 /***********************************************************************************************************************
@@ -0,0 +1,91 @@
+#include "../c++/headers/diatony/FourVoiceTexture.hpp"
+#include "../c++/headers/diatony/SolveDiatony.hpp"
+#include "../c++/headers/diatony/ChainSolver.hpp"
+#include "../c++/headers/aux/Utilities.hpp"
+#include "../c++/headers/aux/Tonality.hpp"
+#include "../c++/headers/aux/MajorTonality.hpp"
+#include "../c++/headers/aux/MinorTonality.hpp"
+
+#include "TestCases.hpp"
+
+using namespace Gecode;
+using namespace std;
+
+/**
+ * Cross-checks the chain dynamic programming solver against the Gecode model on every test case in every tonality.
+ * For each problem, it checks that:
+ *  - the voicing found by the chain solver is a solution of the Gecode model with the same cost vector
+ *  - the Gecode search does not find a better cost vector than the chain solver
+ * It takes as optional argument the time limit of the Gecode search in milliseconds (60 seconds by default), and
+ * prints a CSV line per problem. The return code is 1 if any check failed.
+ */
+int main(int argc, char* argv[]) {
+    const double timeLimit = argc > 1 ? stod(argv[1]) : 60000;
+    bool allChecksPassed = true;
+
+    cout << "Chord progression , Tonality , chain costs , chain time (ms) , voicing accepted by Gecode , Gecode costs , "
+            "Gecode time (ms) , status" << endl;
+    for (int t = 0; t < tonics.size(); t++) {
+        Tonality* tonality;
+        if (modes[t] == MAJOR_MODE)
+            tonality = new MajorTonality(tonics[t]);
+        else
+            tonality = new MinorTonality(tonics[t]);
+
+        for (int c = 0; c < testCases.size(); c++) {
+            const int size = static_cast<int>(testCases[c][0].size());
+            const vector<int> qualities = modes[t] == MAJOR_MODE ? testCases[c][1] : testCases[c][2];
+            auto sectionParams = new TonalProgressionParameters(0, size, 0, size - 1, tonality, testCases[c][0],
+                qualities, testCases[c][3]);
+            auto params = new FourVoiceTextureParameters(size, 1, {sectionParams}, {});
+
+            /// chain solver
+            vector<int> voicing, chainCosts;
+            auto start = std::chrono::high_resolution_clock::now();
+            const bool chainFound = solve_diatony_chain(params, voicing, chainCosts);
+            const std::chrono::duration<double, std::milli> chainTime = std::chrono::high_resolution_clock::now() - start;
+
+            /// the voicing must be a solution of the Gecode model with the same costs
+            bool accepted = false;
+            if (chainFound) {
+                auto check = new FourVoiceTexture(params);
+                check->constrain_voicing(voicing);
+                accepted = check->status() != SS_FAILED && check->get_cost_values() == chainCosts;
+                delete check;
+            }
+
+            /// Gecode search
+            Options opts;
+            opts.threads = 1;
+            opts.stop = Stop::time(timeLimit);
+            opts.cutoff = Cutoff::merge(Cutoff::linear(2 * size), Cutoff::geometric((4 * size)^2, 2));
+            opts.nogoods_limit = size * 4 * 4;
+            start = std::chrono::high_resolution_clock::now();
+            const DiatonySolution sol = solve_diatony(params, &opts);
+            const std::chrono::duration<double, std::milli> gecodeTime = std::chrono::high_resolution_clock::now() - start;
+            const vector<int> gecodeCosts = sol.get_costs();
+
+            string status = "ok";
+            if (!chainFound && sol.found())
+                status = "MISMATCH (Gecode found a solution)";
+            else if (chainFound && !accepted)
+                status = "MISMATCH (voicing rejected)";
+            else if (chainFound && sol.found() && gecodeCosts < chainCosts)
+                status = "MISMATCH (Gecode found a better solution)";
+            else if (chainFound && (!sol.found() || chainCosts < gecodeCosts))
+                status = "ok (Gecode did not reach the optimum)";
+            if (status.find("MISMATCH") != string::npos)
+                allChecksPassed = false;
+
+            cout << testCasesNames[c] << " , " << tonality->get_name() << " , {" << int_vector_to_string(chainCosts)
+                 << "} , " << chainTime.count() << " , " << accepted << " , {" << int_vector_to_string(gecodeCosts)
+                 << "} , " << gecodeTime.count() << " , " << status << endl;
+
+            delete opts.stop;
+            delete params;
+            delete sectionParams;
+        }
+        delete tonality;
+    }
+    return allChecksPassed ? 0 : 1;
+}
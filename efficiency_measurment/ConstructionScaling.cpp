@@ -0,0 +1,50 @@
+#include "../c++/headers/diatony/FourVoiceTexture.hpp"
+#include "../c++/headers/aux/Utilities.hpp"
+#include "../c++/headers/aux/Tonality.hpp"
+#include "../c++/headers/aux/MajorTonality.hpp"
+
+#include "TestCases.hpp"
+
+using namespace Gecode;
+using namespace std;
+
+/**
+ * Measures how the construction of the FourVoiceTexture model grows with the length of the piece. The pieces are made
+ * of repetitions of the third test case in C major, from 1 to 67 repetitions (15 to 1005 chords), in a single section.
+ * For each length, it prints a CSV line with the number of chords, the construction time, the number of propagators
+ * after construction and the number of propagators per chord, which should stay constant. The rules posted for the
+ * longest piece are then printed for each rule family (see ConstraintRegistry).
+ */
+int main(int argc, char* argv[]) {
+    const vector<int> repetitions = {1, 2, 4, 8, 16, 33, 67};
+    auto tonality = new MajorTonality(C);
+    string report;
+
+    cout << "Number of chords , construction time (ms) , propagators , propagators per chord" << endl;
+    for (int r : repetitions) {
+        vector<int> degrees, qualities, states;
+        for (int i = 0; i < r; i++) {
+            degrees.insert(degrees.end(), testCase3[0].begin(), testCase3[0].end());
+            qualities.insert(qualities.end(), testCase3[1].begin(), testCase3[1].end());
+            states.insert(states.end(), testCase3[3].begin(), testCase3[3].end());
+        }
+        const int size = static_cast<int>(degrees.size());
+        auto sectionParams = new TonalProgressionParameters(0, size, 0, size - 1, tonality, degrees, qualities, states);
+        auto params = new FourVoiceTextureParameters(size, 1, {sectionParams}, {});
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        auto pb = new FourVoiceTexture(params);
+        const std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+
+        cout << size << " , " << duration.count() << " , " << pb->propagators() << " , "
+             << static_cast<double>(pb->propagators()) / size << endl;
+        report = pb->get_construction_report();
+
+        delete pb;
+        delete params;
+        delete sectionParams;
+    }
+    cout << report;
+    delete tonality;
+    return 0;
+}
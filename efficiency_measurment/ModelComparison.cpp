@@ -0,0 +1,100 @@
+#include "../c++/headers/diatony/FourVoiceTexture.hpp"
+#include "../c++/headers/diatony/VoicingIndexModel.hpp"
+#include "../c++/headers/aux/Utilities.hpp"
+#include "../c++/headers/aux/Tonality.hpp"
+#include "../c++/headers/aux/MajorTonality.hpp"
+#include "../c++/headers/aux/MinorTonality.hpp"
+
+#include "TestCases.hpp"
+
+using namespace Gecode;
+using namespace std;
+
+/**
+ * Solves a problem with a given model using the same restart-based branch and bound search as solve_diatony, and
+ * returns a CSV line with the size of the model at the root and the statistics of the search.
+ * @param pb the root space of the model. It is deleted by this function.
+ * @param nChords the number of chords of the problem
+ * @param timeLimit the time limit of the search in milliseconds
+ * @param costs the vector in which the costs of the best solution are written (empty if no solution was found)
+ * @return the CSV fields of the model: root propagators, nodes, fails, propagations, time (ms), optimality
+ */
+template<class Model>
+static string run_model(Model* pb, const int nChords, const double timeLimit, vector<int>& costs) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    pb->status();
+    const unsigned int rootPropagators = pb->propagators();
+
+    Options opts;
+    opts.threads = 1;
+    opts.stop = Stop::time(timeLimit);
+    opts.cutoff = Cutoff::merge(Cutoff::linear(2 * nChords), Cutoff::geometric((4 * nChords)^2, 2));
+    opts.nogoods_limit = nChords * 4 * 4;
+    RBS<Model, BAB> solver(pb, opts);
+    delete pb;
+
+    Model* best = nullptr;
+    while (Model* sol = solver.next()) {
+        delete best;
+        best = sol;
+    }
+    const std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+    const Search::Statistics stats = solver.statistics();
+    costs = best != nullptr ? best->get_cost_values() : vector<int>();
+    const bool optimal = !solver.stopped();
+    delete best;
+    delete opts.stop;
+
+    return std::to_string(rootPropagators) + " , " + std::to_string(stats.node) + " , " + std::to_string(stats.fail) +
+        " , " + std::to_string(stats.propagate) + " , " + std::to_string(duration.count()) + " , " +
+        (optimal ? "optimal" : "stopped");
+}
+
+/**
+ * Compares the FourVoiceTexture model with the voicing index model (see VoicingIndexModel) on every test case in every
+ * tonality. Both models are solved with the same search, and the number of propagators at the root, the number of
+ * nodes, fails and propagations, the time and the best costs are printed as CSV lines. If both searches complete, their
+ * costs must be the same.
+ * It takes as optional argument the time limit of each search in milliseconds (60 seconds by default). The return code
+ * is 1 if the models disagree on the optimal costs.
+ */
+int main(int argc, char* argv[]) {
+    const double timeLimit = argc > 1 ? stod(argv[1]) : 60000;
+    bool sameOptimum = true;
+
+    cout << "Chord progression , Tonality , model , root propagators , nodes , fails , propagations , time (ms) , "
+            "status , costs" << endl;
+    for (int t = 0; t < tonics.size(); t++) {
+        Tonality* tonality;
+        if (modes[t] == MAJOR_MODE)
+            tonality = new MajorTonality(tonics[t]);
+        else
+            tonality = new MinorTonality(tonics[t]);
+
+        for (int c = 0; c < testCases.size(); c++) {
+            const int size = static_cast<int>(testCases[c][0].size());
+            const vector<int> qualities = modes[t] == MAJOR_MODE ? testCases[c][1] : testCases[c][2];
+            auto sectionParams = new TonalProgressionParameters(0, size, 0, size - 1, tonality, testCases[c][0],
+                qualities, testCases[c][3]);
+            auto params = new FourVoiceTextureParameters(size, 1, {sectionParams}, {});
+
+            vector<int> fvtCosts, indexCosts;
+            const string fvt = run_model(new FourVoiceTexture(params), size, timeLimit, fvtCosts);
+            const string index = run_model(new VoicingIndexModel(params), size, timeLimit, indexCosts);
+
+            cout << testCasesNames[c] << " , " << tonality->get_name() << " , FourVoiceTexture , " << fvt << " , {"
+                 << int_vector_to_string(fvtCosts) << "}" << endl;
+            cout << testCasesNames[c] << " , " << tonality->get_name() << " , VoicingIndexModel , " << index << " , {"
+                 << int_vector_to_string(indexCosts) << "}" << endl;
+            if (fvt.find("optimal") != string::npos && index.find("optimal") != string::npos && fvtCosts != indexCosts) {
+                cout << "MISMATCH: the models found different optimal costs" << endl;
+                sameOptimum = false;
+            }
+
+            delete params;
+            delete sectionParams;
+        }
+        delete tonality;
+    }
+    return sameOptimum ? 0 : 1;
+}
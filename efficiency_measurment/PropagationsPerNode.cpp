@@ -0,0 +1,87 @@
+#include "../c++/headers/diatony/FourVoiceTexture.hpp"
+#include "../c++/headers/aux/Utilities.hpp"
+#include "../c++/headers/aux/Tonality.hpp"
+#include "../c++/headers/aux/MajorTonality.hpp"
+#include "../c++/headers/aux/MinorTonality.hpp"
+
+#include "TestCases.hpp"
+
+using namespace Gecode;
+using namespace std;
+
+/**
+ * Measures the number of propagations per node of the FourVoiceTexture model on every test case in every tonality,
+ * with the same restart-based branch and bound search as solve_diatony. For each problem, it prints a CSV line with the
+ * number of propagators at the root, the number of nodes, fails and propagations, the propagations per node, the time
+ * and the best costs.
+ * The rules are posted with half reification by default. Compiling with -DDIATONY_FULL_REIFICATION posts them with full
+ * reification instead (see RulePosting.hpp), so that both formulations can be compared on the same corpus (make
+ * propagations runs both).
+ * It takes as optional argument the time limit of each search in milliseconds (60 seconds by default).
+ */
+int main(int argc, char* argv[]) {
+    const double timeLimit = argc > 1 ? stod(argv[1]) : 60000;
+#ifdef DIATONY_FULL_REIFICATION
+    const string formulation = "full reification";
+#else
+    const string formulation = "half reification";
+#endif
+    long long totalNodes = 0, totalPropagations = 0;
+
+    cout << "Chord progression , Tonality , formulation , root propagators , nodes , fails , propagations , "
+            "propagations per node , time (ms) , status , costs" << endl;
+    for (int t = 0; t < tonics.size(); t++) {
+        Tonality* tonality;
+        if (modes[t] == MAJOR_MODE)
+            tonality = new MajorTonality(tonics[t]);
+        else
+            tonality = new MinorTonality(tonics[t]);
+
+        for (int c = 0; c < testCases.size(); c++) {
+            const int size = static_cast<int>(testCases[c][0].size());
+            const vector<int> qualities = modes[t] == MAJOR_MODE ? testCases[c][1] : testCases[c][2];
+            auto sectionParams = new TonalProgressionParameters(0, size, 0, size - 1, tonality, testCases[c][0],
+                qualities, testCases[c][3]);
+            auto params = new FourVoiceTextureParameters(size, 1, {sectionParams}, {});
+
+            const auto start = std::chrono::high_resolution_clock::now();
+            auto pb = new FourVoiceTexture(params);
+            pb->status();
+            const unsigned int rootPropagators = pb->propagators();
+
+            Options opts;
+            opts.threads = 1;
+            opts.stop = Stop::time(timeLimit);
+            opts.cutoff = Cutoff::merge(Cutoff::linear(2 * size), Cutoff::geometric((4 * size)^2, 2));
+            opts.nogoods_limit = size * 4 * 4;
+            RBS<FourVoiceTexture, BAB> solver(pb, opts);
+            delete pb;
+
+            FourVoiceTexture* best = nullptr;
+            while (FourVoiceTexture* sol = solver.next()) {
+                delete best;
+                best = sol;
+            }
+            const std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+            const Search::Statistics stats = solver.statistics();
+            const vector<int> costs = best != nullptr ? best->get_cost_values() : vector<int>();
+            totalNodes += stats.node;
+            totalPropagations += stats.propagate;
+
+            cout << testCasesNames[c] << " , " << tonality->get_name() << " , " << formulation << " , "
+                 << rootPropagators << " , " << stats.node << " , " << stats.fail << " , " << stats.propagate << " , "
+                 << (stats.node > 0 ? static_cast<double>(stats.propagate) / stats.node : 0.0) << " , "
+                 << duration.count() << " , " << (solver.stopped() ? "stopped" : "optimal") << " , {"
+                 << int_vector_to_string(costs) << "}" << endl;
+
+            delete best;
+            delete opts.stop;
+            delete params;
+            delete sectionParams;
+        }
+        delete tonality;
+    }
+    cout << "Total , , " << formulation << " , , " << totalNodes << " , , " << totalPropagations << " , "
+         << (totalNodes > 0 ? static_cast<double>(totalPropagations) / totalNodes : 0.0) << " , , , " << endl;
+    return 0;
+}
@@ -1,4 +1,5 @@
 #!/bin/bash
+# One process is started per test case. make batch_run solves the same test cases inside a single process (see BatchRun.cpp)
 # Define the useful files
 cpp_executable="out/parallelRun"
 inputFile="TestCases.txt"